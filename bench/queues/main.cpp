@@ -0,0 +1,669 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+// throughput and latency of every queue of the library over the grid of
+// producers x consumers x payload sizes x capacities, one line per run (csv or json lines):
+//
+//   queues_bench --queues=spsc_bounded_queue,mpmc_bounded_queue --producers=1,4 --consumers=1,4
+//                --payloads=16,64 --capacities=1024 --messages=1000000 --runs=3 --pin=0,2,4,6 --format=json
+//
+// every message carries the send timestamp, the consumer puts (receive - send) into the histogram;
+// the spmc rings broadcast every message to every consumer, spmc_bounded_message_queue and
+// spmc_bounded_non_uniform_queue never wait for them, so a lapped consumer reports the messages it lost
+// instead of blocking the producer, spmc_broadcast_queue gates the producer on the slowest consumer
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "hope_thread/core/histogram.h"
+#include "hope_thread/containers/queue/spsc_queue.h"
+#include "hope_thread/containers/queue/spsc_bounded_queue.h"
+#include "hope_thread/containers/queue/mpsc_queue.h"
+#include "hope_thread/containers/queue/mpsc_bounded_queue.h"
+#include "hope_thread/containers/queue/mpmc_bounded_queue.h"
+#include "hope_thread/containers/queue/mpmc_queue.h"
+#include "hope_thread/containers/queue/sutter_queue.h"
+#include "hope_thread/containers/queue/spmc_bounded_message_queue.h"
+#include "hope_thread/containers/queue/spmc_bounded_non_uniform_queue.h"
+#include "hope_thread/containers/queue/spmc_broadcast_queue.h"
+
+using namespace hope::threading;
+
+namespace {
+
+    uint64_t now_ns() noexcept {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    template<std::size_t Size>
+    struct payload final {
+        static_assert(Size > 16, "payload has to hold the sequence and the timestamp");
+        uint64_t sequence;
+        uint64_t timestamp;
+        uint8_t body[Size - 16];
+    };
+
+    template<>
+    struct payload<16> final {
+        uint64_t sequence;
+        uint64_t timestamp;
+    };
+
+    enum class topology : uint8_t {
+        spsc,
+        mpsc,
+        mpmc,
+        broadcast // single producer, every consumer receives every message
+    };
+
+    // every adapter exposes try_push for the producers and a reader type for the consumers,
+    // the reader of the shared queues is a thin reference, the broadcast reader owns a ring consumer
+
+    template<typename TQueue>
+    struct shared_reader final {
+        explicit shared_reader(TQueue& in_queue) : queue(in_queue) { }
+
+        template<typename T>
+        bool try_pop(T& v) { return queue.try_pop(v); }
+
+        TQueue& queue;
+    };
+
+    template<typename T>
+    struct spsc_queue_adapter final {
+        constexpr static topology kind = topology::spsc;
+        using reader = shared_reader<spsc_queue_adapter>;
+
+        explicit spsc_queue_adapter(std::size_t capacity) : queue(capacity) { }
+        bool try_push(const T& v) { queue.enqueue(v); return true; }
+        bool try_pop(T& v) { return queue.try_dequeue(v); }
+
+        spsc_queue<T> queue;
+    };
+
+    template<typename T>
+    struct spsc_bounded_queue_adapter final {
+        constexpr static topology kind = topology::spsc;
+        using reader = shared_reader<spsc_bounded_queue_adapter>;
+
+        explicit spsc_bounded_queue_adapter(std::size_t capacity) : queue(capacity) { }
+        bool try_push(const T& v) { return queue.try_enqueue(v); }
+        bool try_pop(T& v) { return queue.try_dequeue(v); }
+
+        spsc_bounded_queue<T> queue;
+    };
+
+    template<typename T>
+    struct sutter_queue_adapter final {
+        constexpr static topology kind = topology::spsc;
+        using reader = shared_reader<sutter_queue_adapter>;
+
+        explicit sutter_queue_adapter(std::size_t) { }
+        bool try_push(const T& v) { queue.enqueue(v); return true; }
+        bool try_pop(T& v) { return queue.dequeue(v); }
+
+        sutter_queue<T> queue;
+    };
+
+    template<typename T>
+    struct mpsc_queue_adapter final {
+        constexpr static topology kind = topology::mpsc;
+        using reader = shared_reader<mpsc_queue_adapter>;
+
+        explicit mpsc_queue_adapter(std::size_t) { }
+        bool try_push(const T& v) { queue.enqueue(v); return true; }
+        bool try_pop(T& v) { return queue.try_dequeue(v); }
+
+        mpsc_queue<T> queue;
+    };
+
+    template<typename T, std::size_t Capacity>
+    struct mpsc_bounded_queue_adapter final {
+        constexpr static topology kind = topology::mpsc;
+        using reader = shared_reader<mpsc_bounded_queue_adapter>;
+
+        explicit mpsc_bounded_queue_adapter(std::size_t) { }
+        bool try_push(const T& v) { return queue->try_enqueue(v); }
+        bool try_pop(T& v) { return queue->try_dequeue(v); }
+
+        std::unique_ptr<mpsc_bounded_queue<T, Capacity>> queue = std::make_unique<mpsc_bounded_queue<T, Capacity>>();
+    };
+
+    template<typename T>
+    struct mpmc_bounded_queue_adapter final {
+        constexpr static topology kind = topology::mpmc;
+        using reader = shared_reader<mpmc_bounded_queue_adapter>;
+
+        explicit mpmc_bounded_queue_adapter(std::size_t capacity) : queue(capacity) { }
+        bool try_push(const T& v) { return queue.try_enqueue(v); }
+        bool try_pop(T& v) { return queue.try_dequeue(v); }
+
+        mpmc_bounded_queue<T> queue;
+    };
+
+    template<typename T>
+    struct mpmc_queue_adapter final {
+        constexpr static topology kind = topology::mpmc;
+        using reader = shared_reader<mpmc_queue_adapter>;
+
+        explicit mpmc_queue_adapter(std::size_t) { }
+        bool try_push(const T& v) { queue.enqueue(v); return true; }
+        bool try_pop(T& v) { return queue.try_dequeue(v); }
+
+        mpmc_queue<T> queue;
+    };
+
+    template<typename T, std::size_t Capacity>
+    struct spmc_bounded_message_queue_adapter final {
+        constexpr static topology kind = topology::broadcast;
+        using queue_t = spmc_bounded_message_queue<T, Capacity, overrun_policy::detect>;
+
+        struct reader final {
+            explicit reader(spmc_bounded_message_queue_adapter& adapter)
+                : consumer(adapter.queue->create_consumer()) { }
+
+            bool try_pop(T& v) { return consumer.try_dequeue(v); }
+
+            typename queue_t::consumer consumer;
+        };
+
+        explicit spmc_bounded_message_queue_adapter(std::size_t) { }
+        bool try_push(const T& v) { return queue->try_enqueue(v); }
+
+        std::unique_ptr<queue_t> queue = std::make_unique<queue_t>();
+    };
+
+    // the byte ring has no overrun detection, a lapped reader sees a frame of the unexpected size
+    // and is resynchronized to the producer, the messages it skipped show up as lost
+    template<typename T, std::size_t BufferSize>
+    struct spmc_bounded_non_uniform_queue_adapter final {
+        constexpr static topology kind = topology::broadcast;
+        using queue_t = spmc_bounded_non_uniform_queue<BufferSize>;
+
+        struct reader final {
+            explicit reader(spmc_bounded_non_uniform_queue_adapter& adapter)
+                : queue(*adapter.queue)
+                , consumer(queue.create_consumer()) { }
+
+            bool try_pop(T& v) {
+                bool valid = true;
+                auto read = [&](uint8_t* data, std::size_t size) {
+                    valid = size == sizeof(T);
+                    if (valid)
+                        std::memcpy(&v, data, sizeof(T));
+                };
+                if (!consumer.try_deserialize(read))
+                    return false;
+                if (!valid)
+                    consumer = queue.create_consumer();
+                return valid;
+            }
+
+            queue_t& queue;
+            typename queue_t::consumer consumer;
+        };
+
+        explicit spmc_bounded_non_uniform_queue_adapter(std::size_t) { }
+        bool try_push(const T& v) {
+            queue->seirialize([&v](uint8_t* data) { std::memcpy(data, &v, sizeof(T)); }, sizeof(T));
+            return true;
+        }
+
+        std::unique_ptr<queue_t> queue = std::make_unique<queue_t>();
+    };
+
+    // the producer gates on the slowest consumer, nothing is lost
+    template<typename T, std::size_t Capacity>
+    struct spmc_broadcast_queue_adapter final {
+        constexpr static topology kind = topology::broadcast;
+        using queue_t = spmc_broadcast_queue<T, Capacity, busy_spin_wait>;
+
+        struct reader final {
+            explicit reader(spmc_broadcast_queue_adapter& adapter)
+                : consumer(adapter.queue->create_consumer()) { }
+
+            bool try_pop(T& v) { return consumer.try_dequeue(v); }
+
+            typename queue_t::consumer consumer;
+        };
+
+        explicit spmc_broadcast_queue_adapter(std::size_t) { }
+        bool try_push(const T& v) { return queue->try_enqueue(v); }
+
+        std::unique_ptr<queue_t> queue = std::make_unique<queue_t>();
+    };
+
+    struct run_params final {
+        std::string queue;
+        std::size_t producers{ 1 };
+        std::size_t consumers{ 1 };
+        std::size_t payload{ 16 };
+        std::size_t capacity{ 1024 };
+        std::size_t messages{ 1'000'000 };
+        std::vector<int> cpus; // empty - threads are not pinned
+    };
+
+    struct run_result final {
+        double seconds{ 0 };
+        uint64_t sent{ 0 };
+        uint64_t received{ 0 };
+        uint64_t lost{ 0 };
+        histogram latency;
+    };
+
+    void pin_current_thread(const std::vector<int>& cpus, std::size_t thread_index) {
+        if (cpus.empty())
+            return;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[thread_index % cpus.size()], &set);
+        (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)thread_index;
+#endif
+    }
+
+    // spins while the queue is full (empty), gives the cpu away once in a while
+    // so that the oversubscribed runs still make progress
+    struct idle final {
+        void operator()() noexcept {
+            if (++spins % 64 == 0)
+                std::this_thread::yield();
+        }
+        std::size_t spins{ 0 };
+    };
+
+    template<typename TAdapter, typename T>
+    run_result run(const run_params& params) {
+        TAdapter adapter(params.capacity);
+
+        const std::size_t per_producer = params.messages / params.producers;
+        const uint64_t total = per_producer * params.producers;
+
+        std::atomic<bool> start{ false };
+        std::atomic<std::size_t> ready{ 0 };
+        std::atomic<std::size_t> producers_left{ params.producers };
+        std::atomic<uint64_t> consumed{ 0 };
+        std::vector<run_result> partial(params.consumers);
+        std::vector<std::thread> ts;
+
+        for (std::size_t p{ 0 }; p < params.producers; ++p) {
+            ts.emplace_back([&, p] {
+                pin_current_thread(params.cpus, p);
+                T message{};
+                ready.fetch_add(1, std::memory_order_acq_rel);
+                while (!start.load(std::memory_order_acquire)) { }
+                idle idle_wait;
+                for (std::size_t i{ 0 }; i < per_producer; ++i) {
+                    message.sequence = i;
+                    message.timestamp = now_ns();
+                    while (!adapter.try_push(message))
+                        idle_wait();
+                }
+                producers_left.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        for (std::size_t c{ 0 }; c < params.consumers; ++c) {
+            ts.emplace_back([&, c] {
+                pin_current_thread(params.cpus, params.producers + c);
+                // broadcast readers have to be attached before the first message is published
+                typename TAdapter::reader reader(adapter);
+                auto&& result = partial[c];
+                T message{};
+                ready.fetch_add(1, std::memory_order_acq_rel);
+                while (!start.load(std::memory_order_acquire)) { }
+                idle idle_wait;
+                if constexpr (TAdapter::kind == topology::broadcast) {
+                    for (;;) {
+                        if (reader.try_pop(message)) {
+                            result.latency.record(now_ns() - message.timestamp);
+                            ++result.received;
+                            if (message.sequence + 1 == total)
+                                break;
+                        } else if (producers_left.load(std::memory_order_acquire) == 0) {
+                            // the producer is done, drain the rest: a resynchronized reader might have
+                            // jumped over the last message
+                            if (!reader.try_pop(message))
+                                break;
+                            result.latency.record(now_ns() - message.timestamp);
+                            ++result.received;
+                        } else {
+                            idle_wait();
+                        }
+                    }
+                    result.lost = total - std::min<uint64_t>(total, result.received);
+                } else {
+                    while (consumed.load(std::memory_order_relaxed) < total) {
+                        if (reader.try_pop(message)) {
+                            result.latency.record(now_ns() - message.timestamp);
+                            ++result.received;
+                            consumed.fetch_add(1, std::memory_order_relaxed);
+                        } else {
+                            idle_wait();
+                        }
+                    }
+                }
+            });
+        }
+
+        while (ready.load(std::memory_order_acquire) != ts.size()) { }
+        auto&& begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (auto&& t : ts)
+            t.join();
+        auto&& elapsed = std::chrono::steady_clock::now() - begin;
+
+        run_result result;
+        result.seconds = std::chrono::duration<double>(elapsed).count();
+        result.sent = total;
+        for (auto&& p : partial) {
+            result.received += p.received;
+            result.lost += p.lost;
+            result.latency.merge(p.latency);
+        }
+        return result;
+    }
+
+    // calls f.template operator()<2^Exp>() for the power of two equal to value
+    template<std::size_t MinExp, typename F, std::size_t... Exp>
+    bool dispatch_pow2(std::size_t value, F&& f, std::index_sequence<Exp...>) {
+        return ((value == (std::size_t(1) << (MinExp + Exp))
+            ? (f.template operator()<(std::size_t(1) << (MinExp + Exp))>(), true)
+            : false) || ...);
+    }
+
+    // compile-time capacities of mpsc_bounded_queue and spmc_bounded_message_queue
+    constexpr std::size_t min_capacity_exp = 6;
+    constexpr std::size_t max_capacity_exp = 16;
+
+    // byte sizes of spmc_bounded_non_uniform_queue
+    constexpr std::size_t min_ring_bytes_exp = 12;
+    constexpr std::size_t max_ring_bytes_exp = 26;
+
+    template<std::size_t PayloadSize>
+    bool run_payload(const run_params& params, run_result& out) {
+        using T = payload<PayloadSize>;
+        const auto& name = params.queue;
+
+        auto&& fixed_capacity = [&](auto&& f) {
+            return dispatch_pow2<min_capacity_exp>(params.capacity, f,
+                std::make_index_sequence<max_capacity_exp - min_capacity_exp + 1>{});
+        };
+
+        if (name == "spsc_queue") {
+            out = run<spsc_queue_adapter<T>, T>(params);
+        } else if (name == "spsc_bounded_queue") {
+            out = run<spsc_bounded_queue_adapter<T>, T>(params);
+        } else if (name == "sutter_queue") {
+            out = run<sutter_queue_adapter<T>, T>(params);
+        } else if (name == "mpsc_queue") {
+            out = run<mpsc_queue_adapter<T>, T>(params);
+        } else if (name == "mpsc_bounded_queue") {
+            return fixed_capacity([&]<std::size_t Capacity>() {
+                out = run<mpsc_bounded_queue_adapter<T, Capacity>, T>(params);
+            });
+        } else if (name == "mpmc_bounded_queue") {
+            out = run<mpmc_bounded_queue_adapter<T>, T>(params);
+        } else if (name == "mpmc_queue") {
+            out = run<mpmc_queue_adapter<T>, T>(params);
+        } else if (name == "spmc_bounded_message_queue") {
+            return fixed_capacity([&]<std::size_t Capacity>() {
+                out = run<spmc_bounded_message_queue_adapter<T, Capacity>, T>(params);
+            });
+        } else if (name == "spmc_broadcast_queue") {
+            return fixed_capacity([&]<std::size_t Capacity>() {
+                out = run<spmc_broadcast_queue_adapter<T, Capacity>, T>(params);
+            });
+        } else if (name == "spmc_bounded_non_uniform_queue") {
+            // the byte ring is sized to hold capacity frames of [size][payload]
+            const auto bytes = std::bit_ceil(params.capacity * (PayloadSize + sizeof(uint32_t)));
+            return dispatch_pow2<min_ring_bytes_exp>(std::clamp(bytes, std::size_t(1) << min_ring_bytes_exp,
+                std::size_t(1) << max_ring_bytes_exp), [&]<std::size_t Bytes>() {
+                out = run<spmc_bounded_non_uniform_queue_adapter<T, Bytes>, T>(params);
+            }, std::make_index_sequence<max_ring_bytes_exp - min_ring_bytes_exp + 1>{});
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    bool run_case(const run_params& params, run_result& out) {
+        switch (params.payload) {
+            case 16: return run_payload<16>(params, out);
+            case 64: return run_payload<64>(params, out);
+            case 256: return run_payload<256>(params, out);
+            case 1024: return run_payload<1024>(params, out);
+            default: return false;
+        }
+    }
+
+    const std::vector<std::pair<std::string, topology>>& known_queues() {
+        static const std::vector<std::pair<std::string, topology>> queues = {
+            { "spsc_queue", topology::spsc },
+            { "spsc_bounded_queue", topology::spsc },
+            { "sutter_queue", topology::spsc },
+            { "mpsc_queue", topology::mpsc },
+            { "mpsc_bounded_queue", topology::mpsc },
+            { "mpmc_bounded_queue", topology::mpmc },
+            { "mpmc_queue", topology::mpmc },
+            { "spmc_bounded_message_queue", topology::broadcast },
+            { "spmc_bounded_non_uniform_queue", topology::broadcast },
+            { "spmc_broadcast_queue", topology::broadcast },
+        };
+        return queues;
+    }
+
+    bool supports(topology kind, std::size_t producers, std::size_t consumers) {
+        switch (kind) {
+            case topology::spsc: return producers == 1 && consumers == 1;
+            case topology::mpsc: return consumers == 1;
+            case topology::mpmc: return true;
+            case topology::broadcast: return producers == 1;
+        }
+        return false;
+    }
+
+    enum class output_format : uint8_t {
+        csv,
+        json // one object per line
+    };
+
+    struct config final {
+        std::vector<std::string> queues;
+        std::vector<std::size_t> producers{ 1 };
+        std::vector<std::size_t> consumers{ 1 };
+        std::vector<std::size_t> payloads{ 16 };
+        std::vector<std::size_t> capacities{ 1024 };
+        std::size_t messages{ 1'000'000 };
+        std::size_t runs{ 1 };
+        std::vector<int> cpus;
+        output_format format{ output_format::csv };
+    };
+
+    std::vector<std::string> split(std::string_view value) {
+        std::vector<std::string> parts;
+        while (!value.empty()) {
+            const auto comma = value.find(',');
+            parts.emplace_back(value.substr(0, comma));
+            if (comma == std::string_view::npos)
+                break;
+            value.remove_prefix(comma + 1);
+        }
+        return parts;
+    }
+
+    std::vector<std::size_t> split_numbers(std::string_view value) {
+        std::vector<std::size_t> numbers;
+        for (auto&& part : split(value))
+            numbers.push_back(std::strtoull(part.c_str(), nullptr, 10));
+        return numbers;
+    }
+
+    void print_usage() {
+        std::cerr << "usage: queues_bench [options]\n"
+            << "  --queues=a,b,...      queues to run (default: all)\n"
+            << "  --producers=n,...     producer counts (default: 1)\n"
+            << "  --consumers=n,...     consumer counts (default: 1)\n"
+            << "  --payloads=n,...      message sizes in bytes: 16, 64, 256, 1024 (default: 16)\n"
+            << "  --capacities=n,...    ring capacities in messages, powers of two (default: 1024)\n"
+            << "  --messages=n          messages per run (default: 1000000)\n"
+            << "  --runs=n              repetitions of every case (default: 1)\n"
+            << "  --pin[=cpu,...]       pin threads to the cpus round robin (default: 0..N-1)\n"
+            << "  --format=csv|json     output format (default: csv)\n"
+            << "queues:";
+        for (auto&& [name, kind] : known_queues())
+            std::cerr << ' ' << name;
+        std::cerr << std::endl;
+    }
+
+    bool parse(int argc, char** argv, config& cfg) {
+        for (int i{ 1 }; i < argc; ++i) {
+            const std::string_view arg(argv[i]);
+            const auto eq = arg.find('=');
+            const auto key = arg.substr(0, eq);
+            const auto value = eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+            if (key == "--queues") {
+                cfg.queues = split(value);
+            } else if (key == "--producers") {
+                cfg.producers = split_numbers(value);
+            } else if (key == "--consumers") {
+                cfg.consumers = split_numbers(value);
+            } else if (key == "--payloads") {
+                cfg.payloads = split_numbers(value);
+            } else if (key == "--capacities") {
+                cfg.capacities = split_numbers(value);
+            } else if (key == "--messages") {
+                cfg.messages = std::strtoull(std::string(value).c_str(), nullptr, 10);
+            } else if (key == "--runs") {
+                cfg.runs = std::strtoull(std::string(value).c_str(), nullptr, 10);
+            } else if (key == "--pin") {
+                cfg.cpus.clear();
+                if (value.empty()) {
+                    for (unsigned cpu{ 0 }; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+                        cfg.cpus.push_back((int)cpu);
+                } else {
+                    for (auto cpu : split_numbers(value))
+                        cfg.cpus.push_back((int)cpu);
+                }
+            } else if (key == "--format" && (value == "csv" || value == "json")) {
+                cfg.format = value == "csv" ? output_format::csv : output_format::json;
+            } else {
+                return false;
+            }
+        }
+
+        if (cfg.queues.empty()) {
+            for (auto&& [name, kind] : known_queues())
+                cfg.queues.push_back(name);
+        }
+        return cfg.messages != 0 && cfg.runs != 0;
+    }
+
+    void print_header(output_format format) {
+        if (format == output_format::csv) {
+            std::cout << "queue,producers,consumers,payload,capacity,messages,run,pinned,seconds,ops_per_sec,"
+                "received,lost,lat_min_ns,lat_mean_ns,lat_p50_ns,lat_p90_ns,lat_p99_ns,lat_p999_ns,lat_max_ns\n";
+        }
+    }
+
+    void print_result(output_format format, const run_params& params, std::size_t run_index, const run_result& r) {
+        const double ops = r.seconds > 0 ? (double)r.sent / r.seconds : 0.0;
+        const auto& lat = r.latency;
+        if (format == output_format::csv) {
+            std::cout << params.queue << ',' << params.producers << ',' << params.consumers << ','
+                << params.payload << ',' << params.capacity << ',' << r.sent << ',' << run_index << ','
+                << (params.cpus.empty() ? 0 : 1) << ',' << r.seconds << ',' << (uint64_t)ops << ','
+                << r.received << ',' << r.lost << ',' << lat.min() << ',' << (uint64_t)lat.mean() << ','
+                << lat.percentile(50) << ',' << lat.percentile(90) << ',' << lat.percentile(99) << ','
+                << lat.percentile(99.9) << ',' << lat.max() << '\n';
+        } else {
+            std::cout << "{\"queue\":\"" << params.queue << "\",\"producers\":" << params.producers
+                << ",\"consumers\":" << params.consumers << ",\"payload\":" << params.payload
+                << ",\"capacity\":" << params.capacity << ",\"messages\":" << r.sent
+                << ",\"run\":" << run_index << ",\"pinned\":" << (params.cpus.empty() ? "false" : "true")
+                << ",\"seconds\":" << r.seconds << ",\"ops_per_sec\":" << (uint64_t)ops
+                << ",\"received\":" << r.received << ",\"lost\":" << r.lost
+                << ",\"latency_ns\":{\"min\":" << lat.min() << ",\"mean\":" << (uint64_t)lat.mean()
+                << ",\"p50\":" << lat.percentile(50) << ",\"p90\":" << lat.percentile(90)
+                << ",\"p99\":" << lat.percentile(99) << ",\"p999\":" << lat.percentile(99.9)
+                << ",\"max\":" << lat.max() << "}}\n";
+        }
+        std::cout.flush();
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    config cfg;
+    if (!parse(argc, argv, cfg)) {
+        print_usage();
+        return 1;
+    }
+
+    print_header(cfg.format);
+    for (auto&& name : cfg.queues) {
+        auto&& known = std::find_if(known_queues().begin(), known_queues().end(),
+            [&](auto&& q) { return q.first == name; });
+        if (known == known_queues().end()) {
+            std::cerr << "unknown queue: " << name << std::endl;
+            return 1;
+        }
+
+        for (auto producers : cfg.producers) {
+            for (auto consumers : cfg.consumers) {
+                if (producers == 0 || consumers == 0 || !supports(known->second, producers, consumers))
+                    continue;
+                for (auto payload_size : cfg.payloads) {
+                    for (auto capacity : cfg.capacities) {
+                        run_params params;
+                        params.queue = name;
+                        params.producers = producers;
+                        params.consumers = consumers;
+                        params.payload = payload_size;
+                        params.capacity = capacity;
+                        params.messages = cfg.messages;
+                        params.cpus = cfg.cpus;
+
+                        for (std::size_t run_index{ 0 }; run_index < cfg.runs; ++run_index) {
+                            run_result result;
+                            if (!run_case(params, result)) {
+                                std::cerr << "unsupported case: " << name << " payload " << payload_size
+                                    << " capacity " << capacity << std::endl;
+                                break;
+                            }
+                            print_result(cfg.format, params, run_index, result);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
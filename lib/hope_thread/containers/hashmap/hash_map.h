@@ -74,7 +74,8 @@ namespace hope::threading {
         template <typename> typename TExclusiveLock = std::unique_lock,
         template <typename> typename TSharedLock = std::shared_lock,
         std::size_t BucketsCount = 8,
-        std::size_t ResizeFactor = 2
+        std::size_t ResizeFactor = 2,
+        typename TAllocator = std::allocator<key_value<TKey, TValue>>
     >
     class hash_map final {
     public:
@@ -105,7 +106,7 @@ namespace hope::threading {
         }
     private:
         hash_storage<key_value<TKey, TValue>, map_traits<TKey, TValue>, THasher<TKey>,
-            TEqual, TMutex, TExclusiveLock, TSharedLock, BucketsCount, ResizeFactor> m_storage;
+            TEqual, TMutex, TExclusiveLock, TSharedLock, BucketsCount, ResizeFactor, TAllocator> m_storage;
     };
 
 }
\ No newline at end of file
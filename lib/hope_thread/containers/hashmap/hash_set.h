@@ -33,8 +33,9 @@ namespace hope::threading {
         template <typename> typename TExclusiveLock = std::unique_lock,
         template <typename> typename TSharedLock = std::shared_lock,
         std::size_t BucketsCount = 8,
-        std::size_t ResizeFactor = 2
+        std::size_t ResizeFactor = 2,
+        typename TAllocator = std::allocator<TValue>
     >
     using hash_set = hash_storage<TValue, set_traits<TValue>, THasher,
-        TEqual, TMutex, TExclusiveLock, TSharedLock, BucketsCount, ResizeFactor>;
+        TEqual, TMutex, TExclusiveLock, TSharedLock, BucketsCount, ResizeFactor, TAllocator>;
 }
\ No newline at end of file
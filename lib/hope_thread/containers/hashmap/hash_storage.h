@@ -13,6 +13,7 @@
 #include <list>
 #include <atomic>
 #include <algorithm>
+#include <memory>
 
 namespace hope::threading {
 
@@ -23,7 +24,7 @@ namespace hope::threading {
         }
     };
 
-    // TODO:: add allocator
+    // TAllocator is used for the nodes of the collision lists only, the bucket arrays are allocated rarely
     template<
         typename TValue,
         typename TKeyTraits,
@@ -33,7 +34,8 @@ namespace hope::threading {
         template <typename> typename TExclusiveLock,
         template <typename> typename TSharedLock,
         std::size_t BucketsCount = 8,
-        std::size_t ResizeFactor = 2
+        std::size_t ResizeFactor = 2,
+        typename TAllocator = std::allocator<TValue>
     >
     class hash_storage final {
         static_assert((BucketsCount & (BucketsCount - 1)) == 0);
@@ -41,7 +43,8 @@ namespace hope::threading {
         using shared_lock_t = TSharedLock<TMutex>;
         using exclusive_lock_t = TExclusiveLock<TMutex>;
 
-        using collision_list_t = std::list<TValue>;
+        using allocator_t = typename std::allocator_traits<TAllocator>::template rebind_alloc<TValue>;
+        using collision_list_t = std::list<TValue, allocator_t>;
         using bucket_t = std::vector<collision_list_t>;
 
         struct lockable_bucket final {
@@ -55,9 +58,10 @@ namespace hope::threading {
 
         using storage_t = std::array<lockable_bucket, BucketsCount>;
     
-        hash_storage() {
+        explicit hash_storage(const TAllocator& allocator = TAllocator())
+            : m_allocator(allocator) {
             for (auto&& b : m_storage)
-                b.bucket.resize(1);
+                b.bucket = make_bucket(1);
         }
 
         template<typename... Ts>
@@ -161,6 +165,14 @@ namespace hope::threading {
             return found != end(collision_list) ? &(*found) : nullptr;
         }
 
+        bucket_t make_bucket(std::size_t capacity) const {
+            bucket_t bucket;
+            bucket.reserve(capacity);
+            for (std::size_t i = 0; i < capacity; ++i)
+                bucket.emplace_back(m_allocator);
+            return bucket;
+        }
+
         void resize(lockable_bucket& bucket) const {
             bool resizing = false;
             if (!bucket.resizing.compare_exchange_strong(resizing, true,
@@ -173,8 +185,7 @@ namespace hope::threading {
                 // TODO:: probably better to add something like flat-combining
                 // and do not try to resize the bucket inside the loop, but instead share the value 
                 // via the active resizing context or something like that
-                bucket_t new_bucket;
-                new_bucket.resize(bucket_capacity);
+                bucket_t new_bucket = make_bucket(bucket_capacity);
 
                 // prepare bucket for swap
                 {
@@ -208,6 +219,7 @@ namespace hope::threading {
 
         THasher m_hasher;
         TEqual m_equal;
+        [[no_unique_address]] allocator_t m_allocator;
         storage_t m_storage;
     };
 
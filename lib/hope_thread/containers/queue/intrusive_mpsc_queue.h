@@ -0,0 +1,102 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // link embedded into the user's object, the object has to derive from it;
+    // copies of the object start unlinked
+    struct mpsc_hook {
+        mpsc_hook() noexcept = default;
+        mpsc_hook(const mpsc_hook&) noexcept { }
+        mpsc_hook& operator=(const mpsc_hook&) noexcept { return *this; }
+
+        std::atomic<mpsc_hook*> next{ nullptr };
+    };
+
+    // Vyukov's intrusive mpsc queue: the queue only links caller-owned objects,
+    // enqueue is a single exchange and never allocates;
+    // an object must stay alive and must not be enqueued again until it is dequeued
+    template<typename T>
+    class intrusive_mpsc_queue final {
+        static_assert(std::is_base_of_v<mpsc_hook, T>, "T must derive from mpsc_hook");
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(intrusive_mpsc_queue)
+
+        intrusive_mpsc_queue() {
+            m_head.store(&m_stub, std::memory_order_relaxed);
+            m_tail = &m_stub;
+        }
+
+        ~intrusive_mpsc_queue() = default;
+
+        // might be called from any thread
+        void enqueue(T* item) noexcept {
+            push(static_cast<mpsc_hook*>(item));
+        }
+
+        // consumer only; returns nullptr if the queue is empty,
+        // or if the producer which owns the next item has not linked it yet
+        T* try_dequeue() noexcept {
+            auto* tail = m_tail;
+            auto* next = tail->next.load(std::memory_order_acquire);
+            if (tail == &m_stub) {
+                if (next == nullptr)
+                    return nullptr;
+                // skip the stub
+                m_tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next != nullptr) {
+                m_tail = next;
+                return static_cast<T*>(tail);
+            }
+
+            if (tail != m_head.load(std::memory_order_acquire))
+                return nullptr;
+
+            // tail is the last item, put the stub behind it to be able to detach the item
+            push(&m_stub);
+            next = tail->next.load(std::memory_order_acquire);
+            if (next != nullptr) {
+                m_tail = next;
+                return static_cast<T*>(tail);
+            }
+
+            return nullptr;
+        }
+
+        // consumer only; the tail is either the stub or the next item to be returned
+        bool empty() const noexcept {
+            return m_tail == &m_stub && m_stub.next.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        void push(mpsc_hook* hook) noexcept {
+            hook->next.store(nullptr, std::memory_order_relaxed);
+            auto* prev = m_head.exchange(hook, std::memory_order_acq_rel);
+            prev->next.store(hook, std::memory_order_release);
+        }
+
+        // producer part
+        alignas(CACHE_LINE_SIZE) std::atomic<mpsc_hook*> m_head{ nullptr };
+
+        // consumer part
+        alignas(CACHE_LINE_SIZE) mpsc_hook* m_tail{ nullptr };
+        mpsc_hook m_stub;
+    };
+
+}
@@ -0,0 +1,660 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/platform/mapped_file.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // persistent append log, the same [size][payload] framing as spmc_bounded_non_uniform_queue, but over
+    // memory mapped files rolled every roll_size bytes:
+    //     <directory>/<name>.<cycle>.journal   header + frames, the frame is published by the release store of its size,
+    //                                          a size of 0xffffffff marks the end of the file (the writer rolled over)
+    //     <directory>/<name>.<cycle>.index     the offset of every index_spacing-th message of the file
+    // the writer fills the payload right in the mapped page, the readers (tailing ones as well, in other processes)
+    // get the payload right from the same page cache pages, nothing is copied on either side;
+    // every message has a sequence number (its position in the whole journal), a reader might seek to any of them;
+    // msync and the creation of the next file happen in a background thread, so appending never makes a syscall
+    // except for the roll over itself, which only swaps the mapping prepared in advance
+    struct journal_options final {
+        const char* directory{ "." };
+        const char* name{ "journal" };
+        // size of every file
+        std::size_t roll_size{ 64 * 1024 * 1024 };
+        // messages between two entries of the index
+        uint32_t index_spacing{ 64 };
+        // msync and roll over preparation in a background thread, otherwise the next file is created on roll over
+        // and nothing is synced until flush()
+        bool background{ true };
+        std::chrono::milliseconds flush_interval{ 10 };
+    };
+
+    namespace detail::journal {
+
+        constexpr uint64_t k_magic = 0x314c4e524a504f48ull; // "HOPJRNL1"
+        constexpr uint32_t k_version = 1;
+        constexpr uint32_t k_end_of_file = 0xffffffffu;
+
+        // zero magic: the file is created in advance and is not used yet
+        struct alignas(CACHE_LINE_SIZE) file_header final {
+            uint64_t magic;
+            uint32_t version;
+            uint32_t index_spacing;
+            uint64_t cycle;
+            uint64_t first_sequence;
+            uint64_t file_size;
+        };
+
+        constexpr std::size_t k_header_size = sizeof(file_header);
+
+        // frames are 4 byte aligned, so the size word is always an aligned atomic
+        constexpr std::size_t frame_size(std::size_t payload) noexcept {
+            return sizeof(uint32_t) + (payload + 3) / 4 * 4;
+        }
+
+        // the smallest frame is 8 bytes, so this many index entries are enough for any file
+        constexpr std::size_t index_capacity(std::size_t file_size, uint32_t spacing) noexcept {
+            return (file_size - k_header_size) / frame_size(1) / spacing + 1;
+        }
+
+        constexpr std::size_t index_file_size(std::size_t file_size, uint32_t spacing) noexcept {
+            return k_header_size + index_capacity(file_size, spacing) * sizeof(uint64_t);
+        }
+
+        inline std::string file_path(const std::string& directory, const std::string& name, uint64_t cycle, const char* extension) {
+            char suffix[48];
+            std::snprintf(suffix, sizeof(suffix), ".%08llu.%s", static_cast<unsigned long long>(cycle), extension);
+            return (std::filesystem::path(directory) / (name + suffix)).string();
+        }
+
+        // cycles of the journal files present in the directory, ascending
+        inline std::vector<uint64_t> list_cycles(const std::string& directory, const std::string& name) {
+            std::vector<uint64_t> cycles;
+            std::error_code ec;
+            for (auto&& entry : std::filesystem::directory_iterator(directory, ec)) {
+                const auto file = entry.path().filename().string();
+                const auto prefix = name + ".";
+                if (file.size() <= prefix.size() || file.compare(0, prefix.size(), prefix) != 0)
+                    continue;
+                unsigned long long cycle = 0;
+                char extension[16]{ };
+                if (std::sscanf(file.c_str() + prefix.size(), "%llu.%15s", &cycle, extension) == 2
+                    && std::strcmp(extension, "journal") == 0)
+                    cycles.push_back(cycle);
+            }
+            std::sort(cycles.begin(), cycles.end());
+            return cycles;
+        }
+
+        inline const file_header& header_of(const platform::mapped_file& file) noexcept {
+            return *std::launder(static_cast<const file_header*>(file.data));
+        }
+
+        // the rest of the header is published by the release store of the magic
+        inline uint64_t magic_of(const platform::mapped_file& file) noexcept {
+            return std::atomic_ref<uint64_t>(const_cast<file_header&>(header_of(file)).magic).load(std::memory_order_acquire);
+        }
+
+        inline bool is_valid(const platform::mapped_file& file) noexcept {
+            if (file.size < k_header_size || magic_of(file) != k_magic)
+                return false;
+            auto&& header = header_of(file);
+            return header.version == k_version && header.file_size <= file.size;
+        }
+
+        // a frame of the size at the offset and the size word after it stay within the file,
+        // anything else is not a frame the writer has published
+        constexpr bool frame_fits(std::size_t offset, uint32_t size, std::size_t file_size) noexcept {
+            return offset + frame_size(size) + sizeof(uint32_t) <= file_size;
+        }
+
+        inline std::atomic<uint32_t>& size_word(const platform::mapped_file& file, std::size_t offset) noexcept {
+            return *std::launder(reinterpret_cast<std::atomic<uint32_t>*>(static_cast<uint8_t*>(file.data) + offset));
+        }
+
+        inline std::atomic<uint64_t>& index_entry(const platform::mapped_file& index, std::size_t entry) noexcept {
+            return *std::launder(reinterpret_cast<std::atomic<uint64_t>*>(
+                static_cast<uint8_t*>(index.data) + k_header_size + entry * sizeof(uint64_t)));
+        }
+
+        // a journal file with its index
+        struct cycle_files final {
+            void close() noexcept {
+                platform::close_mapped_file(journal);
+                platform::close_mapped_file(index);
+            }
+
+            bool valid() const noexcept {
+                return journal.data != nullptr && index.data != nullptr;
+            }
+
+            platform::mapped_file journal;
+            platform::mapped_file index;
+            uint64_t cycle{ 0 };
+        };
+
+    } // namespace detail::journal
+
+    // single writer of a journal, several writers of the same journal are not supported
+    class journal_writer final {
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(journal_writer)
+
+        journal_writer() = default;
+
+        ~journal_writer() {
+            close();
+        }
+
+        // continues after the last complete message of the last started file of the journal, with the roll size
+        // and the index spacing the journal was created with (the options only apply to a new journal);
+        // starts a new journal if no file of the directory has been started; false if the last started file
+        // can not be opened or is not a journal file, nothing is written then
+        bool open(const journal_options& options) {
+            using namespace detail::journal;
+            assert(!valid());
+            assert(options.index_spacing > 0 && options.roll_size > k_header_size + 2 * frame_size(1));
+            m_directory = options.directory;
+            m_name = options.name;
+            m_roll_size = options.roll_size;
+            m_index_spacing = options.index_spacing;
+
+            std::error_code ec;
+            std::filesystem::create_directories(m_directory, ec);
+
+            // the last started file, the ones after it were prepared in advance and hold nothing
+            auto cycles = list_cycles(m_directory, m_name);
+            for (auto it = cycles.rbegin(); it != cycles.rend() && !m_current.valid(); ++it) {
+                const auto state = open_existing_cycle(*it, m_current);
+                if (state == cycle_state::broken)
+                    return false;
+                if (state == cycle_state::unused)
+                    remove_cycle(*it);
+            }
+
+            if (!m_current.valid()) {
+                if (!open_cycle(0, m_current))
+                    return false;
+                start_cycle(0);
+            } else if (!recover()) {
+                m_current.close();
+                return false;
+            }
+
+            if (options.background) {
+                m_flush_interval = options.flush_interval;
+                m_maintenance = std::jthread([this](std::stop_token token) {
+                    run_maintenance(token);
+                });
+            }
+            return true;
+        }
+
+        // syncs everything written and closes the files
+        void close() {
+            if (!valid())
+                return;
+            if (m_maintenance.joinable()) {
+                m_maintenance.request_stop();
+                m_maintenance.join();
+            }
+            for (auto&& files : m_retired)
+                files.close();
+            m_retired.clear();
+            if (m_prepared.valid())
+                m_prepared.close();
+            flush();
+            m_current.close();
+        }
+
+        bool valid() const noexcept {
+            return m_current.valid();
+        }
+
+        // f(uint8_t*) writes size bytes of the message right into the file; false if the message does not fit a file
+        // (or the next file could not be created)
+        template<typename F>
+        bool append(std::size_t size, F&& f) {
+            using namespace detail::journal;
+            assert(size > 0 && "empty messages are not supported");
+            if (size == 0 || size > max_payload())
+                return false;
+
+            const auto frame = frame_size(size);
+            // room for the end of file mark has to stay
+            if (m_offset + frame + sizeof(uint32_t) > m_roll_size && !roll())
+                return false;
+
+            f(static_cast<uint8_t*>(m_current.journal.data) + m_offset + sizeof(uint32_t));
+            if (m_until_index == 0) {
+                index_entry(m_current.index, m_index_next++).store(m_offset, std::memory_order_release);
+                m_until_index = m_index_spacing;
+            }
+            --m_until_index;
+            size_word(m_current.journal, m_offset).store(static_cast<uint32_t>(size), std::memory_order_release);
+
+            m_offset += frame;
+            ++m_sequence;
+            m_written.store(m_offset, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool append(const void* data, std::size_t size) {
+            return append(size, [data, size](uint8_t* payload) {
+                std::memcpy(payload, data, size);
+            });
+        }
+
+        // sequence number the next message gets
+        uint64_t sequence() const noexcept {
+            return m_sequence;
+        }
+
+        uint64_t cycle() const noexcept {
+            return m_current.cycle;
+        }
+
+        std::size_t max_payload() const noexcept {
+            return (m_roll_size - detail::journal::k_header_size - 2 * sizeof(uint32_t)) / 4 * 4;
+        }
+
+        // writes everything appended so far back to the file, blocks until it is done
+        void flush() noexcept {
+            (void)platform::sync_mapped_file(m_current.journal, 0, m_offset, false);
+            (void)platform::sync_mapped_file(m_current.index, 0, m_current.index.size, false);
+        }
+
+    private:
+        enum class cycle_state : uint8_t {
+            unused,     // no header yet, created in advance
+            started,
+            broken,     // can not be opened or is not a journal file
+        };
+
+        // maps the whole file as it was created, whatever the options are now
+        cycle_state open_existing_cycle(uint64_t cycle, detail::journal::cycle_files& files) const {
+            using namespace detail::journal;
+            const auto journal_path = file_path(m_directory, m_name, cycle, "journal");
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(journal_path, ec);
+            if (ec)
+                return cycle_state::broken;
+            if (size < k_header_size)
+                return cycle_state::unused;
+
+            files.cycle = cycle;
+            if (!platform::open_mapped_file(journal_path.c_str(), true, &files.journal))
+                return cycle_state::broken;
+            auto&& header = header_of(files.journal);
+            if (magic_of(files.journal) == 0) {
+                files.close();
+                return cycle_state::unused;
+            }
+            if (!is_valid(files.journal) || header.cycle != cycle || header.index_spacing == 0
+                || header.file_size <= k_header_size + 2 * frame_size(1)
+                || !platform::open_mapped_file(file_path(m_directory, m_name, cycle, "index").c_str(), true, &files.index)
+                || files.index.size < index_file_size(header.file_size, header.index_spacing)) {
+                files.close();
+                return cycle_state::broken;
+            }
+            return cycle_state::started;
+        }
+
+        void remove_cycle(uint64_t cycle) const {
+            using namespace detail::journal;
+            std::error_code ec;
+            std::filesystem::remove(file_path(m_directory, m_name, cycle, "journal"), ec);
+            std::filesystem::remove(file_path(m_directory, m_name, cycle, "index"), ec);
+        }
+
+        bool open_cycle(uint64_t cycle, detail::journal::cycle_files& files) const {
+            using namespace detail::journal;
+            files.cycle = cycle;
+            if (!platform::create_or_open_mapped_file(file_path(m_directory, m_name, cycle, "journal").c_str(),
+                    m_roll_size, &files.journal))
+                return false;
+            if (!platform::create_or_open_mapped_file(file_path(m_directory, m_name, cycle, "index").c_str(),
+                    index_file_size(m_roll_size, m_index_spacing), &files.index)) {
+                files.close();
+                return false;
+            }
+            return true;
+        }
+
+        // the header is written before anybody can reach the file through the end of file mark of the previous one
+        void start_cycle(uint64_t first_sequence) noexcept {
+            using namespace detail::journal;
+            auto* header = static_cast<file_header*>(m_current.journal.data);
+            header->version = k_version;
+            header->index_spacing = m_index_spacing;
+            header->cycle = m_current.cycle;
+            header->first_sequence = first_sequence;
+            header->file_size = m_roll_size;
+            std::atomic_ref<uint64_t>(header->magic).store(k_magic, std::memory_order_release);
+
+            m_sequence = first_sequence;
+            m_offset = k_header_size;
+            m_index_next = 0;
+            m_until_index = 0;
+            m_written.store(m_offset, std::memory_order_relaxed);
+        }
+
+        // the file might have been written by another (crashed) writer with other options,
+        // the ones of the header are kept for the following files as well;
+        // whatever follows the last complete frame (the payload of a message that was being appended) is zeroed,
+        // otherwise the next frames would be followed by stale bytes taken for a size word
+        bool recover() {
+            using namespace detail::journal;
+            auto&& header = header_of(m_current.journal);
+            m_roll_size = header.file_size;
+            m_index_spacing = header.index_spacing;
+
+            std::size_t count{ 0 };
+            auto offset = k_header_size;
+            uint32_t size{ 0 };
+            while (offset + sizeof(uint32_t) <= m_roll_size) {
+                size = size_word(m_current.journal, offset).load(std::memory_order_acquire);
+                if (size == 0 || size == k_end_of_file)
+                    break;
+                if (!frame_fits(offset, size, m_roll_size)) {
+                    size = 0;
+                    break;
+                }
+                offset += frame_size(size);
+                ++count;
+            }
+
+            m_sequence = header.first_sequence + count;
+            m_offset = offset;
+            m_index_next = (count + m_index_spacing - 1) / m_index_spacing;
+            m_until_index = static_cast<uint32_t>(m_index_next * m_index_spacing - count);
+            m_written.store(m_offset, std::memory_order_relaxed);
+            if (size != k_end_of_file) {
+                std::memset(static_cast<uint8_t*>(m_current.journal.data) + m_offset, 0, m_roll_size - m_offset);
+                const auto entries = index_capacity(m_roll_size, m_index_spacing);
+                for (auto entry = m_index_next; entry < entries; ++entry)
+                    index_entry(m_current.index, entry).store(0, std::memory_order_relaxed);
+            }
+            if (size == k_end_of_file)
+                return roll_to(m_current.cycle + 1, false);
+            return true;
+        }
+
+        bool roll() {
+            return roll_to(m_current.cycle + 1, true);
+        }
+
+        bool roll_to(uint64_t next_cycle, bool mark_end) {
+            detail::journal::cycle_files next;
+            {
+                std::lock_guard lock(m_mutex);
+                if (m_prepared.valid() && m_prepared.cycle == next_cycle)
+                    std::swap(next, m_prepared);
+            }
+            if (!next.valid() && !open_cycle(next_cycle, next))
+                return false;
+
+            auto previous = m_current;
+            const auto end_offset = m_offset;
+            {
+                // the background thread takes a copy of the current files
+                std::lock_guard lock(m_mutex);
+                m_current = next;
+            }
+            start_cycle(m_sequence);
+            if (mark_end) {
+                // a tailing reader follows the mark only once the next file is ready
+                detail::journal::size_word(previous.journal, end_offset).store(detail::journal::k_end_of_file,
+                    std::memory_order_release);
+            }
+
+            if (m_maintenance.joinable()) {
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_retired.push_back(previous);
+                }
+                m_wake_up.notify_one();
+            } else {
+                (void)platform::sync_mapped_file(previous.journal, 0, previous.journal.size, false);
+                (void)platform::sync_mapped_file(previous.index, 0, previous.index.size, false);
+                previous.close();
+            }
+            return true;
+        }
+
+        // schedules the write back of the new pages, closes the retired files, creates the next file in advance
+        void run_maintenance(std::stop_token token) {
+            uint64_t synced_cycle = m_current.cycle;
+            std::size_t synced{ 0 };
+            for (;;) {
+                std::vector<detail::journal::cycle_files> retired;
+                detail::journal::cycle_files current;
+                bool prepare;
+                {
+                    std::unique_lock lock(m_mutex);
+                    retired.swap(m_retired);
+                    current = m_current;
+                    prepare = !m_prepared.valid();
+                }
+
+                if (current.cycle != synced_cycle) {
+                    synced_cycle = current.cycle;
+                    synced = 0;
+                }
+                const auto written = std::min(m_written.load(std::memory_order_relaxed), current.journal.size);
+                if (written > synced) {
+                    (void)platform::sync_mapped_file(current.journal, synced, written - synced, true);
+                    (void)platform::sync_mapped_file(current.index, 0, current.index.size, true);
+                    synced = written;
+                }
+                for (auto&& files : retired) {
+                    (void)platform::sync_mapped_file(files.journal, 0, files.journal.size, true);
+                    (void)platform::sync_mapped_file(files.index, 0, files.index.size, true);
+                    files.close();
+                }
+
+                if (prepare) {
+                    detail::journal::cycle_files next;
+                    if (open_cycle(current.cycle + 1, next)) {
+                        std::lock_guard lock(m_mutex);
+                        if (m_current.cycle + 1 == next.cycle && !m_prepared.valid())
+                            std::swap(next, m_prepared);
+                    }
+                    if (next.valid())
+                        next.close();
+                }
+
+                if (token.stop_requested())
+                    break;
+                std::unique_lock lock(m_mutex);
+                m_wake_up.wait_for(lock, token, m_flush_interval, [this] { return !m_retired.empty(); });
+            }
+        }
+
+        // writer only
+        detail::journal::cycle_files m_current;
+        std::size_t m_offset{ 0 };
+        uint64_t m_sequence{ 0 };
+        std::size_t m_index_next{ 0 };
+        uint32_t m_until_index{ 0 };
+        std::size_t m_roll_size{ 0 };
+        uint32_t m_index_spacing{ 1 };
+        std::string m_directory;
+        std::string m_name;
+
+        // end of the written part of the current file, read by the background thread
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_written{ 0 };
+
+        // shared with the background thread
+        alignas(CACHE_LINE_SIZE) std::mutex m_mutex;
+        std::condition_variable_any m_wake_up;
+        detail::journal::cycle_files m_prepared;
+        std::vector<detail::journal::cycle_files> m_retired;
+        std::chrono::milliseconds m_flush_interval{ 10 };
+        std::jthread m_maintenance;
+    };
+
+    // reads a journal from any message, follows the writer when it reaches the end (tailing)
+    class journal_reader final {
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(journal_reader)
+
+        journal_reader() = default;
+
+        ~journal_reader() {
+            close();
+        }
+
+        // positioned at the first message of the journal; false if the writer has not started the journal yet
+        bool open(const journal_options& options) {
+            assert(!valid());
+            m_directory = options.directory;
+            m_name = options.name;
+            for (auto cycle : detail::journal::list_cycles(m_directory, m_name)) {
+                if (open_cycle(cycle))
+                    return true;
+            }
+            return false;
+        }
+
+        void close() noexcept {
+            m_current.close();
+        }
+
+        bool valid() const noexcept {
+            return m_current.valid();
+        }
+
+        // f(const uint8_t*, std::size_t) gets the next message right in the mapped file, false if the reader is at the end
+        template<typename F>
+        bool try_read(F&& f) {
+            using namespace detail::journal;
+            for (;;) {
+                const auto size = size_word(m_current.journal, m_offset).load(std::memory_order_acquire);
+                if (size == 0 || (size != k_end_of_file && !frame_fits(m_offset, size, header_of(m_current.journal).file_size)))
+                    return false;
+                if (size == k_end_of_file) {
+                    // the writer has prepared the next file before it marked the end of this one
+                    if (!open_cycle(m_current.cycle + 1))
+                        return false;
+                    continue;
+                }
+                f(static_cast<const uint8_t*>(m_current.journal.data) + m_offset + sizeof(uint32_t), std::size_t(size));
+                m_offset += frame_size(size);
+                ++m_sequence;
+                return true;
+            }
+        }
+
+        // the next try_read returns the message with the sequence number; false if it is not written yet
+        // (or was removed), the position does not change then
+        bool seek(uint64_t sequence) {
+            using namespace detail::journal;
+            auto cycles = list_cycles(m_directory, m_name);
+            for (auto it = cycles.rbegin(); it != cycles.rend(); ++it) {
+                detail::journal::cycle_files files;
+                if (!map_cycle(*it, files))
+                    continue;
+                auto&& header = header_of(files.journal);
+                if (header.first_sequence > sequence) {
+                    files.close();
+                    continue;
+                }
+
+                const auto in_file = sequence - header.first_sequence;
+                const auto entry = in_file / header.index_spacing;
+                if (entry >= index_capacity(header.file_size, header.index_spacing)) {
+                    files.close();
+                    return false;
+                }
+                auto offset = static_cast<std::size_t>(index_entry(files.index, entry).load(std::memory_order_acquire));
+                if (offset == 0 || offset % sizeof(uint32_t) != 0 || offset + sizeof(uint32_t) > header.file_size) {
+                    files.close();
+                    return false;
+                }
+                // the frames up to the requested one and the requested one itself have to be written
+                for (auto skip = in_file % header.index_spacing;; --skip) {
+                    const auto size = size_word(files.journal, offset).load(std::memory_order_acquire);
+                    if (size == 0 || size == k_end_of_file || !frame_fits(offset, size, header.file_size)) {
+                        files.close();
+                        return false;
+                    }
+                    if (skip == 0)
+                        break;
+                    offset += frame_size(size);
+                }
+
+                m_current.close();
+                m_current = files;
+                m_offset = offset;
+                m_sequence = sequence;
+                return true;
+            }
+            return false;
+        }
+
+        // sequence number of the message the next try_read returns
+        uint64_t sequence() const noexcept {
+            return m_sequence;
+        }
+
+        uint64_t cycle() const noexcept {
+            return m_current.cycle;
+        }
+
+    private:
+        bool map_cycle(uint64_t cycle, detail::journal::cycle_files& files) const {
+            using namespace detail::journal;
+            files.cycle = cycle;
+            if (!platform::open_mapped_file(file_path(m_directory, m_name, cycle, "journal").c_str(), false, &files.journal))
+                return false;
+            // the file prepared in advance has no header yet
+            if (!is_valid(files.journal)
+                || !platform::open_mapped_file(file_path(m_directory, m_name, cycle, "index").c_str(), false, &files.index)) {
+                files.close();
+                return false;
+            }
+            return true;
+        }
+
+        bool open_cycle(uint64_t cycle) {
+            detail::journal::cycle_files files;
+            if (!map_cycle(cycle, files))
+                return false;
+            m_current.close();
+            m_current = files;
+            m_offset = detail::journal::k_header_size;
+            m_sequence = detail::journal::header_of(files.journal).first_sequence;
+            return true;
+        }
+
+        detail::journal::cycle_files m_current;
+        std::size_t m_offset{ 0 };
+        uint64_t m_sequence{ 0 };
+        std::string m_directory;
+        std::string m_name;
+    };
+
+}
@@ -0,0 +1,158 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // multi producer flavour of spmc_bounded_non_uniform_queue: producers reserve the space with a single fetch_add
+    // and commit their records independently of each other, every consumer reads all the records in the reservation order
+    // and stops at the first one which is not committed yet;
+    // record: [u64 commit stamp][u32 size][u32 span][payload][pad], records are aligned to 16 bytes
+    template<std::size_t BufferSize>
+    class alignas(CACHE_LINE_SIZE) mpmc_bounded_non_uniform_queue final {
+        static_assert(BufferSize > 0, "BufferSize must be greater than zero");
+        static_assert((BufferSize & (BufferSize - 1)) == 0, "BufferSize must be pow of 2");
+        static_assert(BufferSize >= 64, "BufferSize is too small to hold any record");
+
+        struct record_header final {
+            // absolute position of the record + 1, stored last
+            uint64_t stamp;
+            uint32_t size;
+            uint32_t span;
+        };
+
+        constexpr static std::size_t record_alignment = 16;
+        constexpr static uint32_t padding_size = UINT32_MAX;
+
+        static_assert(sizeof(record_header) == record_alignment);
+    public:
+        ~mpmc_bounded_non_uniform_queue() = default;
+        mpmc_bounded_non_uniform_queue() = default;
+
+        // the biggest payload a single record could hold, a record which does not fit till the end of the ring
+        // always fits right after the padding
+        constexpr static std::size_t max_size = BufferSize / 2 - sizeof(record_header);
+
+        struct consumer final {
+            consumer(mpmc_bounded_non_uniform_queue* in_impl) {
+                m_queue_impl = in_impl;
+                m_local_read_position = m_queue_impl->m_reserve_pos.load(std::memory_order_acquire);
+            }
+
+            // hands the payload of the next committed record to f right in the ring
+            template<typename F>
+            bool try_deserialize(F& f) {
+                for (;;) {
+                    auto* header = m_queue_impl->header_at(m_local_read_position);
+                    const std::atomic_ref<uint64_t> stamp(header->stamp);
+                    if (stamp.load(std::memory_order_acquire) != m_local_read_position + 1) {
+                        // the record is either not committed yet or it was already overwritten by the next lap,
+                        // in the latter case the boundaries of the old records are lost,
+                        // the only known record boundary is the latest reservation
+                        const auto reserve_pos = m_queue_impl->m_reserve_pos.load(std::memory_order_relaxed);
+                        if (reserve_pos - m_local_read_position > BufferSize) {
+                            m_local_read_position = reserve_pos;
+                        }
+                        return false;
+                    }
+
+                    // seqlock style: a producer of the next lap might be rewriting the header right now,
+                    // the fields count only if the record is still there after they were read
+                    const auto size = std::atomic_ref<uint32_t>(header->size).load(std::memory_order_relaxed);
+                    const auto span = std::atomic_ref<uint32_t>(header->span).load(std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    const auto reserve_pos = m_queue_impl->m_reserve_pos.load(std::memory_order_relaxed);
+                    if (stamp.load(std::memory_order_relaxed) != m_local_read_position + 1
+                        || reserve_pos - m_local_read_position > BufferSize
+                        || !is_valid(size, span)) {
+                        m_local_read_position = reserve_pos;
+                        return false;
+                    }
+
+                    m_local_read_position += span;
+                    if (size != padding_size) {
+                        f(reinterpret_cast<uint8_t*>(header + 1), (std::size_t)size);
+                        return true;
+                    }
+                }
+            }
+        private:
+            // a torn header must not move the reader off the record grid or out of the ring
+            static bool is_valid(uint32_t size, uint32_t span) noexcept {
+                if (span == 0 || span % record_alignment != 0 || span > BufferSize)
+                    return false;
+                return size == padding_size || size + sizeof(record_header) <= span;
+            }
+
+            std::size_t m_local_read_position{ 0 };
+            mpmc_bounded_non_uniform_queue* m_queue_impl{ nullptr };
+        };
+
+        // serialize message to the queue, might be called from any thread;
+        // the record never wraps, if the reserved space crosses the end of the ring, it is given away as padding
+        // and the space is reserved again
+        template<typename F>
+        void seirialize(F&& f, const std::size_t size) {
+            assert(size <= max_size);
+            const auto span = align(sizeof(record_header) + size);
+            for (;;) {
+                const auto start = m_reserve_pos.fetch_add(span, std::memory_order_relaxed);
+                const auto offset = start & (BufferSize - 1);
+                if (offset + span <= BufferSize) {
+                    f(reinterpret_cast<uint8_t*>(header_at(start) + 1));
+                    commit(start, (uint32_t)size, span);
+                    return;
+                }
+
+                const auto till_end = BufferSize - offset;
+                commit(start, padding_size, till_end);
+                commit(start + till_end, padding_size, span - till_end);
+            }
+        }
+
+        consumer create_consumer() {
+            return consumer{ this };
+        }
+
+    private:
+        constexpr static std::size_t align(std::size_t size) noexcept {
+            return (size + record_alignment - 1) & ~(record_alignment - 1);
+        }
+
+        record_header* header_at(std::size_t position) noexcept {
+            return std::launder(reinterpret_cast<record_header*>(m_buffer.data() + (position & (BufferSize - 1))));
+        }
+
+        void commit(std::size_t position, uint32_t size, std::size_t span) noexcept {
+            auto* header = header_at(position);
+            std::atomic_ref<uint32_t>(header->size).store(size, std::memory_order_relaxed);
+            std::atomic_ref<uint32_t>(header->span).store((uint32_t)span, std::memory_order_relaxed);
+            std::atomic_ref<uint64_t>(header->stamp).store(position + 1, std::memory_order_release);
+        }
+
+        // the next free byte, every value it takes is a boundary of some record
+        std::atomic<std::size_t> m_reserve_pos{ };
+
+        char pad[CACHE_LINE_SIZE]{ };
+
+        // zeroed stamps are never valid
+        alignas(CACHE_LINE_SIZE) std::array<uint8_t, BufferSize> m_buffer{ };
+
+        friend struct consumer;
+    };
+
+}
@@ -9,67 +9,119 @@
 #pragma once
 
 #include <atomic>
+#include <iterator>
+#include <new>
+#include <type_traits>
 
+#include "hope_thread/core/instrumentation.h"
 #include "hope_thread/foundation.h"
 #include <cassert>
 
 namespace hope::threading {
 
+    enum class mpmc_layout : uint8_t {
+        padded, // every cell occupies its own cache line
+        packed  // several cells share a cache line, neighbour positions are remapped to the different lines
+    };
+
     // i have no idea how it works
-    template<typename TItem>
+    // TInstrumentation: see core/instrumentation.h, nothing is recorded by default
+    template<typename TItem, mpmc_layout layout = mpmc_layout::padded,
+             typename TInstrumentation = default_queue_instrumentation>
     class mpmc_bounded_queue final {
     public:
         HOPE_THREADING_CONSTRUCTABLE_ONLY(mpmc_bounded_queue)
 
         explicit mpmc_bounded_queue(std::size_t size)
-            : m_buffer_mask(size - 1){
+            : m_buffer_mask(size - 1)
+            , m_shuffle_bits(compute_shuffle_bits(size)) {
 
             assert((size > 1) && ((size & (size - 1)) == 0));
-            m_buffer = new cell[size];
+            m_buffer = static_cast<cell*>(::operator new(sizeof(cell) * size, std::align_val_t{ cacheline_size }));
 
             for(std::size_t i{ 0 }; i < size; ++i)
-                m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+                new (&m_buffer[i]) cell;
+
+            // sequence of the position is stored in the cell the position is remapped to
+            for(std::size_t i{ 0 }; i < size; ++i)
+                cell_at(i).sequence.store(i, std::memory_order_relaxed);
 
             m_enqueue_pos.store(0, std::memory_order_relaxed);
             m_dequeue_pos.store(0, std::memory_order_relaxed);
         }
 
         ~mpmc_bounded_queue() {
-            delete[] m_buffer;
+            if constexpr (!std::is_trivially_destructible_v<TItem>) {
+                // everything between the consumers and the producers is still alive, except for the skipped cells
+                const auto last = m_enqueue_pos.load(std::memory_order_relaxed);
+                for (auto pos = m_dequeue_pos.load(std::memory_order_relaxed); pos != last; ++pos) {
+                    if (cell_at(pos).sequence.load(std::memory_order_relaxed) == pos + 1)
+                        cell_at(pos).item()->~TItem();
+                }
+            }
+            for(std::size_t i{ 0 }; i <= m_buffer_mask; ++i)
+                m_buffer[i].~cell();
+            ::operator delete(m_buffer, std::align_val_t{ cacheline_size });
         }
 
         template<typename T>
         bool try_enqueue(T&& in_value) {
+            return try_emplace(std::forward<T>(in_value));
+        }
+
+        // constructs the item directly in the slot; if the constructor throws, the slot is given away
+        // as if it was consumed already (the consumers skip it) and the exception is rethrown
+        template<typename... Args>
+        bool try_emplace(Args&&... args) {
             cell* pushed;
+            std::size_t retries{ 0 };
             std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
             for (;;) {
-                const auto popped_pos = pos & m_buffer_mask;
-                pushed = &m_buffer[popped_pos];
+                pushed = &cell_at(pos);
                 const std::size_t seq = pushed->sequence.load(std::memory_order_acquire);
                 const intptr_t dif = (intptr_t)seq - (intptr_t)pos;
                 if (dif == 0) {
-                    if (m_enqueue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed, 
+                    if (m_enqueue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed,
                                                                         std::memory_order_relaxed)){
                         break;
                     }
                 } else if (dif < 0){
+                    m_instrumentation.on_retries(retries);
+                    m_instrumentation.on_full();
                     return false;
-                } else { 
+                } else {
                     pos = m_enqueue_pos.load(std::memory_order_relaxed);
                 }
+                ++retries;
             }
+            m_instrumentation.on_retries(retries);
 
-            pushed->data = std::forward<T>(in_value);
+            try {
+                new (pushed->storage) TItem(std::forward<Args>(args)...);
+            } catch (...) {
+                skip(pos);
+                throw;
+            }
+            pushed->enqueued_at = m_instrumentation.on_enqueue();
             pushed->sequence.store(pos + 1, std::memory_order_release);
             return true;
-        }   
+        }
 
         bool try_dequeue(TItem& out_value) {
+            return try_consume([&out_value](TItem&& item) {
+                out_value = std::move(item);
+            });
+        }
+
+        // passes the item to the visitor (as an rvalue) right in the slot, the item is destroyed afterwards;
+        // the visitor must not throw
+        template<typename F>
+        bool try_consume(F&& f) {
             cell* popped;
+            std::size_t retries{ 0 };
             size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
             for (;;) {
-                const auto popped_pos = pos & m_buffer_mask;
-                popped = &m_buffer[popped_pos];
+                popped = &cell_at(pos);
                 const std::size_t seq = popped->sequence.load(std::memory_order_acquire);
                 const intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
                 if (dif == 0) {
@@ -78,29 +130,216 @@ namespace hope::threading {
                         break;
                     }
                 } else if (dif < 0) {
+                    m_instrumentation.on_retries(retries);
+                    m_instrumentation.on_empty();
                     return false;
                 } else {
-                    pos = m_dequeue_pos.load(std::memory_order_relaxed);
+                    pos = skip_or_reload(pos);
                 }
+                ++retries;
             }
-            out_value = std::move(popped->data);
+            m_instrumentation.on_retries(retries);
+            auto* item = popped->item();
+            const auto enqueued_at = popped->enqueued_at;
+            std::forward<F>(f)(std::move(*item));
+            item->~TItem();
             popped->sequence.store(pos + m_buffer_mask + 1, std::memory_order_release);
+            m_instrumentation.on_dequeue(enqueued_at);
             return true;
         }
 
+        // claims as many consecutive free cells as possible (up to the size of the range) with a single CAS,
+        // then fills them in order; returns the count of enqueued items, elements are constructed from *first
+        // (pass std::move_iterator to move them)
+        template<typename It>
+        std::size_t try_enqueue_bulk(It first, It last) {
+            const auto requested = (std::size_t)std::distance(first, last);
+            if (requested == 0)
+                return 0;
+
+            std::size_t count;
+            std::size_t retries{ 0 };
+            std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            for (;; ++retries) {
+                count = 0;
+                bool outdated = false;
+                while (count < requested && count <= m_buffer_mask) {
+                    const std::size_t seq = cell_at(pos + count).sequence.load(std::memory_order_acquire);
+                    const intptr_t dif = (intptr_t)seq - (intptr_t)(pos + count);
+                    if (dif != 0) {
+                        // dif > 0 means another producer already went past this position
+                        outdated = dif > 0;
+                        break;
+                    }
+                    ++count;
+                }
+
+                if (count == 0 && !outdated) {
+                    m_instrumentation.on_retries(retries);
+                    m_instrumentation.on_full();
+                    return 0;
+                }
+
+                if (count != 0 && m_enqueue_pos.compare_exchange_strong(pos, pos + count, std::memory_order_relaxed,
+                                                                                std::memory_order_relaxed)) {
+                    break;
+                }
+
+                if (count == 0)
+                    pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+
+            m_instrumentation.on_retries(retries);
+            for (std::size_t i{ 0 }; i < count; ++i, ++first) {
+                auto&& pushed = cell_at(pos + i);
+                try {
+                    new (pushed.storage) TItem(*first);
+                } catch (...) {
+                    for (auto j = i; j < count; ++j)
+                        skip(pos + j);
+                    throw;
+                }
+                pushed.enqueued_at = m_instrumentation.on_enqueue();
+                pushed.sequence.store(pos + i + 1, std::memory_order_release);
+            }
+            return count;
+        }
+
+        // drains up to max_count consecutive ready cells claimed with a single CAS, items are moved to out in FIFO order;
+        // returns the count of dequeued items
+        template<typename OutIt>
+        std::size_t try_dequeue_bulk(OutIt out, std::size_t max_count) {
+            if (max_count == 0)
+                return 0;
+
+            std::size_t count;
+            std::size_t retries{ 0 };
+            std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            for (;; ++retries) {
+                count = 0;
+                bool outdated = false;
+                while (count < max_count && count <= m_buffer_mask) {
+                    const std::size_t seq = cell_at(pos + count).sequence.load(std::memory_order_acquire);
+                    const intptr_t dif = (intptr_t)seq - (intptr_t)(pos + count + 1);
+                    if (dif != 0) {
+                        outdated = dif > 0;
+                        break;
+                    }
+                    ++count;
+                }
+
+                if (count == 0 && !outdated) {
+                    m_instrumentation.on_retries(retries);
+                    m_instrumentation.on_empty();
+                    return 0;
+                }
+
+                if (count != 0 && m_dequeue_pos.compare_exchange_strong(pos, pos + count, std::memory_order_relaxed,
+                                                                                std::memory_order_relaxed)) {
+                    break;
+                }
+
+                if (count == 0)
+                    pos = skip_or_reload(pos);
+            }
+
+            m_instrumentation.on_retries(retries);
+            for (std::size_t i{ 0 }; i < count; ++i, ++out) {
+                auto&& popped = cell_at(pos + i);
+                auto* item = popped.item();
+                const auto enqueued_at = popped.enqueued_at;
+                *out = std::move(*item);
+                item->~TItem();
+                popped.sequence.store(pos + i + m_buffer_mask + 1, std::memory_order_release);
+                m_instrumentation.on_dequeue(enqueued_at);
+            }
+            return count;
+        }
+
+        std::size_t capacity() const noexcept {
+            return m_buffer_mask + 1;
+        }
+
+        // memory occupied by the ring itself
+        std::size_t storage_size() const noexcept {
+            return sizeof(cell) * capacity();
+        }
+
+        // might be called from any thread at any moment, all zeros unless the queue is instrumented
+        queue_stats stats() const {
+            return m_instrumentation.stats();
+        }
+
     private:
-        constexpr std::size_t static cacheline_size = 64;
+        constexpr std::size_t static cacheline_size = CACHE_LINE_SIZE;
+
+        // the item lives in the raw storage, it is constructed by the producer and destroyed by the consumer
+        struct cell_base {
+            TItem* item() noexcept {
+                return std::launder(reinterpret_cast<TItem*>(storage));
+            }
 
-        struct alignas(cacheline_size) cell final {
             std::atomic<std::size_t> sequence;
-            TItem data;
+            alignas(TItem) unsigned char storage[sizeof(TItem)];
+            [[no_unique_address]] typename TInstrumentation::timestamp_t enqueued_at;
         };
 
+        struct alignas(cacheline_size) padded_cell final : cell_base { };
+
+        struct packed_cell final : cell_base { };
+
+        using cell = std::conditional_t<layout == mpmc_layout::padded, padded_cell, packed_cell>;
+
+        constexpr static std::size_t cells_per_line() noexcept {
+            std::size_t count{ 1 };
+            while (count * 2 * sizeof(cell) <= cacheline_size)
+                count *= 2;
+            return count;
+        }
+
+        // the same trick as in atomic_queue: the lowest bits of the index are swapped with the next ones,
+        // so that consecutive positions are spread over the different cache lines
+        static std::size_t compute_shuffle_bits(std::size_t size) noexcept {
+            std::size_t bits{ 0 };
+            while ((std::size_t(1) << (bits + 1)) <= cells_per_line())
+                ++bits;
+            // the permutation works inside of blocks of cells_per_line^2 cells
+            return size >= (std::size_t(1) << (bits * 2)) ? bits : 0;
+        }
+
+        std::size_t remap(std::size_t pos) const noexcept {
+            const std::size_t index = pos & m_buffer_mask;
+            if constexpr (layout == mpmc_layout::padded) {
+                return index;
+            } else {
+                const std::size_t mix = (index ^ (index >> m_shuffle_bits)) & ((std::size_t(1) << m_shuffle_bits) - 1);
+                return index ^ mix ^ (mix << m_shuffle_bits);
+            }
+        }
+
+        cell& cell_at(std::size_t pos) const noexcept {
+            return m_buffer[remap(pos)];
+        }
+
+        // the producer of the position could not construct the item, the cell is released as a consumed one
+        void skip(std::size_t pos) noexcept {
+            cell_at(pos).sequence.store(pos + m_buffer_mask + 1, std::memory_order_release);
+        }
+
+        // the cell of the position is ahead of the consumer: either the position is outdated, or the cell
+        // was skipped by its producer, the latter is the case only if nobody has moved the dequeue position yet
+        std::size_t skip_or_reload(std::size_t pos) noexcept {
+            if (m_dequeue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+                return pos + 1;
+            return pos;
+        }
+
         using padding_t = uint8_t[cacheline_size];
 
         padding_t m_padding0 { };
         cell* m_buffer;
         const std::size_t m_buffer_mask;
+        const std::size_t m_shuffle_bits;
 
         padding_t m_padding1 { };
         std::atomic<std::size_t> m_enqueue_pos{};
@@ -108,6 +347,8 @@ namespace hope::threading {
         padding_t m_padding2 { };
         std::atomic<size_t> m_dequeue_pos{};
         padding_t m_padding3{};
+
+        [[no_unique_address]] TInstrumentation m_instrumentation;
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,217 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#include "hope_thread/foundation.h"
+#include "hope_thread/synchronization/spinlock.h"
+
+namespace hope::threading {
+
+    // unbounded mpmc queue: a chain of segments, every segment is a run of the mpmc_bounded_queue cells
+    // which cover SegmentSize consecutive global positions; a segment is used once:
+    // the producer which claims the last cell of the segment links the next one (taken from the pool if possible),
+    // the consumer which claims the last cell moves the consumers to the next segment,
+    // the segment goes back to the pool when all of its cells are consumed;
+    // segments are released only by the destructor, so a thread holding a stale segment pointer
+    // never touches freed memory, the cell sequences filter out the stale positions
+    template<typename TItem, std::size_t SegmentSize = 1024>
+    class mpmc_queue final {
+        static_assert(SegmentSize > 2, "SegmentSize must be greater than two");
+        static_assert((SegmentSize & (SegmentSize - 1)) == 0, "SegmentSize must be pow of 2");
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(mpmc_queue)
+
+        mpmc_queue() {
+            auto* first = acquire_segment(0);
+            m_head.store(first, std::memory_order_relaxed);
+            m_tail.store(first, std::memory_order_relaxed);
+        }
+
+        ~mpmc_queue() {
+            auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            const auto last = m_enqueue_pos.load(std::memory_order_relaxed);
+            auto* seg = m_head.load(std::memory_order_relaxed);
+            while (seg != nullptr) {
+                if constexpr (!std::is_trivially_destructible_v<TItem>) {
+                    const auto base = seg->base.load(std::memory_order_relaxed);
+                    for (; pos != last && pos < base + SegmentSize; ++pos)
+                        seg->cells[pos - base].item()->~TItem();
+                }
+                auto* next = seg->next.load(std::memory_order_relaxed);
+                delete seg;
+                seg = next;
+            }
+
+            while (m_pool != nullptr) {
+                auto* next = m_pool->next.load(std::memory_order_relaxed);
+                delete m_pool;
+                m_pool = next;
+            }
+        }
+
+        // never fails, allocates only when the current segment is exhausted and the pool is empty
+        template<typename T>
+        void enqueue(T&& in_value) {
+            emplace(std::forward<T>(in_value));
+        }
+
+        template<typename... Args>
+        void emplace(Args&&... args) {
+            for (;;) {
+                auto* seg = m_tail.load(std::memory_order_acquire);
+                const auto base = seg->base.load(std::memory_order_acquire);
+                auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                if (pos - base >= SegmentSize) {
+                    // the producer of the last cell has not linked the next segment yet
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                auto&& pushed = seg->cells[pos - base];
+                if (pushed.sequence.load(std::memory_order_acquire) != pos
+                    || !m_enqueue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed,
+                                                                            std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                if (pos - base == SegmentSize - 1) {
+                    auto* next = acquire_segment(base + SegmentSize);
+                    seg->next.store(next, std::memory_order_release);
+                    m_tail.store(next, std::memory_order_release);
+                }
+
+                new (pushed.storage) TItem(std::forward<Args>(args)...);
+                pushed.sequence.store(pos + 1, std::memory_order_release);
+                return;
+            }
+        }
+
+        bool try_dequeue(TItem& out_value) {
+            return try_consume([&out_value](TItem&& item) {
+                out_value = std::move(item);
+            });
+        }
+
+        // passes the item to the visitor (as an rvalue) right in the cell, the item is destroyed afterwards;
+        // the visitor must not throw
+        template<typename F>
+        bool try_consume(F&& f) {
+            for (;;) {
+                auto* seg = m_head.load(std::memory_order_acquire);
+                const auto base = seg->base.load(std::memory_order_acquire);
+                auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+                if (pos - base >= SegmentSize) {
+                    // the consumer of the last cell has not moved the head yet
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                auto&& popped = seg->cells[pos - base];
+                const std::size_t seq = popped.sequence.load(std::memory_order_acquire);
+                const intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+                if (dif < 0)
+                    return false;
+                if (dif > 0 || !m_dequeue_pos.compare_exchange_strong(pos, pos + 1, std::memory_order_relaxed,
+                                                                                    std::memory_order_relaxed)) {
+                    continue;
+                }
+
+                if (pos - base == SegmentSize - 1) {
+                    // linked by the producer before it published this cell
+                    m_head.store(seg->next.load(std::memory_order_acquire), std::memory_order_release);
+                }
+
+                auto* item = popped.item();
+                std::forward<F>(f)(std::move(*item));
+                item->~TItem();
+
+                // neither producers nor consumers point to the segment once all of its cells are consumed
+                if (seg->consumed.fetch_add(1, std::memory_order_acq_rel) == SegmentSize - 1)
+                    release_segment(seg);
+                return true;
+            }
+        }
+
+        // approximate
+        std::size_t size() const noexcept {
+            const auto dequeue_pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            const auto enqueue_pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+        }
+
+    private:
+        struct alignas(CACHE_LINE_SIZE) cell final {
+            TItem* item() noexcept {
+                return std::launder(reinterpret_cast<TItem*>(storage));
+            }
+
+            std::atomic<std::size_t> sequence;
+            alignas(TItem) unsigned char storage[sizeof(TItem)];
+        };
+
+        struct segment final {
+            // the base is published last, whoever reads it with acquire sees the fresh sequences
+            void reset(std::size_t in_base) noexcept {
+                next.store(nullptr, std::memory_order_relaxed);
+                consumed.store(0, std::memory_order_relaxed);
+                for (std::size_t i{ 0 }; i < SegmentSize; ++i)
+                    cells[i].sequence.store(in_base + i, std::memory_order_relaxed);
+                base.store(in_base, std::memory_order_release);
+            }
+
+            cell cells[SegmentSize];
+            alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> base{ 0 };
+            std::atomic<segment*> next{ nullptr };
+            std::atomic<std::size_t> consumed{ 0 };
+        };
+
+        segment* acquire_segment(std::size_t base) {
+            segment* seg = nullptr;
+            {
+                std::lock_guard lk(m_pool_lock);
+                if (m_pool != nullptr) {
+                    seg = m_pool;
+                    m_pool = m_pool->next.load(std::memory_order_relaxed);
+                }
+            }
+            if (seg == nullptr)
+                seg = new segment;
+            seg->reset(base);
+            return seg;
+        }
+
+        void release_segment(segment* seg) {
+            std::lock_guard lk(m_pool_lock);
+            seg->next.store(m_pool, std::memory_order_relaxed);
+            m_pool = seg;
+        }
+
+        using padding_t = uint8_t[CACHE_LINE_SIZE];
+
+        padding_t m_padding0{ };
+        std::atomic<std::size_t> m_enqueue_pos{ 0 };
+        std::atomic<segment*> m_tail{ nullptr };
+
+        padding_t m_padding1{ };
+        std::atomic<std::size_t> m_dequeue_pos{ 0 };
+        std::atomic<segment*> m_head{ nullptr };
+
+        padding_t m_padding2{ };
+        spinlock m_pool_lock;
+        segment* m_pool{ nullptr };
+    };
+
+}
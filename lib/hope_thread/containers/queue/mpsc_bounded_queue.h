@@ -12,11 +12,13 @@
 #include <array>
 #include <atomic>
 
+#include "hope_thread/core/instrumentation.h"
 #include "hope_thread/foundation.h"
 
 namespace hope::threading {
 
-    template<typename T, std::size_t Size>
+    // TInstrumentation: see core/instrumentation.h, nothing is recorded by default
+    template<typename T, std::size_t Size, typename TInstrumentation = default_queue_instrumentation>
     class mpsc_bounded_queue final {
     public:
         HOPE_THREADING_CONSTRUCTABLE_ONLY(mpsc_bounded_queue)
@@ -30,39 +32,60 @@ namespace hope::threading {
         template<typename TVal>
         bool try_enqueue(TVal&& v) {
             auto cur_head = m_head.load(std::memory_order_relaxed);
+            std::size_t retries{ 0 };
             while (true){
-                if (cur_head - m_tail > m_buffer_size) return false;
+                if (cur_head - m_tail.load(std::memory_order_acquire) >= m_buffer_size) {
+                    m_instrumentation.on_retries(retries);
+                    m_instrumentation.on_full();
+                    return false;
+                }
                 if (m_head.compare_exchange_strong(cur_head, cur_head + 1,
                                                    std::memory_order_relaxed, std::memory_order_relaxed)){
                     break;
                 }
+                ++retries;
             }
+            m_instrumentation.on_retries(retries);
 
             const auto actual_index = cur_head & m_buffer_mask;
             m_buffer[actual_index].value = std::forward<TVal>(v);
+            m_buffer[actual_index].enqueued_at = m_instrumentation.on_enqueue();
             m_buffer[actual_index].ready.store(true, std::memory_order_release);
             return true;
         }
 
         bool try_dequeue(T& v) {
-            if (m_head.load(std::memory_order_relaxed) == m_tail)
+            const auto cur_tail = m_tail.load(std::memory_order_relaxed);
+            if (m_head.load(std::memory_order_relaxed) == cur_tail) {
+                m_instrumentation.on_empty();
                 return false;
+            }
 
-            const auto actual_index = m_tail & m_buffer_mask;
-            if (!m_buffer[actual_index].ready){
+            const auto actual_index = cur_tail & m_buffer_mask;
+            if (!m_buffer[actual_index].ready.load(std::memory_order_acquire)){
+                m_instrumentation.on_empty();
                 return false;
             }
             v = std::move(m_buffer[actual_index].value);
+            const auto enqueued_at = m_buffer[actual_index].enqueued_at;
             m_buffer[actual_index].ready.store(false, std::memory_order_release);
-            ++m_tail;
+            // the slot is handed back to the producers only after it is marked as free
+            m_tail.store(cur_tail + 1, std::memory_order_release);
+            m_instrumentation.on_dequeue(enqueued_at);
             return true;
         }
 
+        // might be called from any thread at any moment, all zeros unless the queue is instrumented
+        queue_stats stats() const {
+            return m_instrumentation.stats();
+        }
+
     private:
 
         struct alignas(64) node final {
           T value;
           std::atomic<bool> ready{ false };
+          [[no_unique_address]] typename TInstrumentation::timestamp_t enqueued_at;
         };
 
         const std::size_t m_buffer_mask;
@@ -72,11 +95,13 @@ namespace hope::threading {
 
         const char padding1[64]{ };
 
-        std::size_t m_tail{ 0 };
+        std::atomic<std::size_t> m_tail{ 0 };
 
         const char padding2[64]{ };
 
         std::array<node, Size> m_buffer;
+
+        [[no_unique_address]] TInstrumentation m_instrumentation;
     };
 
 }
\ No newline at end of file
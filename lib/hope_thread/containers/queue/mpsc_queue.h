@@ -9,6 +9,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include "hope_thread/synchronization/backoff.h"
 #include "hope_thread/foundation.h"
@@ -20,21 +21,23 @@ namespace hope::threading {
         new_only
     };
 
-    template<typename TItem, alloc_policy policy = alloc_policy::new_only>
+    template<typename TItem, alloc_policy policy = alloc_policy::new_only, typename TAllocator = std::allocator<TItem>>
     class mpsc_queue final {
     public:
         HOPE_THREADING_CONSTRUCTABLE_ONLY(mpsc_queue);
 
-        explicit mpsc_queue() {
-            m_head = m_tail = m_buffer_head = new node();
+        explicit mpsc_queue(const TAllocator& allocator = TAllocator())
+            : m_allocator(allocator) {
+            m_head = m_tail = m_buffer_head = create_node();
         }
 
         ~mpsc_queue() {
-            while (m_tail != nullptr) {
-                auto* cur_node = m_tail;
-                m_tail = m_tail->next;
-
-                delete cur_node;
+            // consumed nodes of the buffered queue are still linked in front of the tail
+            auto* cur_node = policy == alloc_policy::buffered ? m_buffer_head.load() : m_tail.load();
+            while (cur_node != nullptr) {
+                auto* next = cur_node->next.load(std::memory_order_relaxed);
+                destroy_node(cur_node);
+                cur_node = next;
             }
         }
 
@@ -44,23 +47,25 @@ namespace hope::threading {
             if constexpr (policy == alloc_policy::buffered){
                 new_node = alloc_node(std::forward<T>(in_value));
             } else{
-                new_node = new node(std::forward<T>(in_value));
+                new_node = create_node(std::forward<T>(in_value));
             }
             
             auto* old_head = m_head.exchange(new_node);
-            old_head->next = new_node;
+            // publishes the constructed node to the consumer
+            old_head->next.store(new_node, std::memory_order_release);
         }
 
         bool try_dequeue(TItem& v) {
-            auto* popped = m_tail->next;
+            auto* old_tail = m_tail.load(std::memory_order_relaxed);
+            auto* popped = old_tail->next.load(std::memory_order_acquire);
 
             if (popped) {
                 v = std::move(popped->value);
-                auto* old_tail = m_tail;
-                m_tail = popped;
-                m_tail->value = { };
+                // the buffered queue recycles the nodes in front of the tail, they are not touched from now on
+                m_tail.store(popped, std::memory_order_release);
+                popped->value = { };
                 if constexpr (policy == alloc_policy::new_only){
-                    delete old_tail;
+                    destroy_node(old_tail);
                 }
                 return true;
             }
@@ -68,6 +73,29 @@ namespace hope::threading {
             return false;
         }
 
+        // consumer only; walks the whole chain which is linked at the moment and hands the items
+        // to the callback in FIFO order, returns the count of consumed items
+        template<typename F>
+        std::size_t consume_all(F&& f) {
+            auto* cur = m_tail.load(std::memory_order_relaxed);
+            std::size_t count{ 0 };
+            for (auto* next = cur->next.load(std::memory_order_acquire); next != nullptr;
+                    next = cur->next.load(std::memory_order_acquire)) {
+                f(std::move(next->value));
+                if constexpr (policy == alloc_policy::new_only){
+                    destroy_node(cur);
+                }
+                cur = next;
+                ++count;
+            }
+
+            if (count != 0) {
+                cur->value = { };
+                m_tail.store(cur, std::memory_order_release);
+            }
+            return count;
+        }
+
     private:
         // internal node structure 
         struct node final {
@@ -75,25 +103,46 @@ namespace hope::threading {
             explicit node(T&& in_value = T{})
                 : value(std::forward<T>(in_value)) { }
 
-            node* volatile next = nullptr;
+            std::atomic<node*> next = nullptr;
             TItem value;
         };
 
+        using node_allocator_t = typename std::allocator_traits<TAllocator>::template rebind_alloc<node>;
+        using node_traits_t = std::allocator_traits<node_allocator_t>;
+
+        // might be called by any producer, the allocator has to be thread safe
+        template<typename... Args>
+        node* create_node(Args&&... args) {
+            node* n = node_traits_t::allocate(m_allocator, 1);
+            try {
+                node_traits_t::construct(m_allocator, n, std::forward<Args>(args)...);
+            } catch (...) {
+                node_traits_t::deallocate(m_allocator, n, 1);
+                throw;
+            }
+            return n;
+        }
+
+        void destroy_node(node* n) {
+            node_traits_t::destroy(m_allocator, n);
+            node_traits_t::deallocate(m_allocator, n, 1);
+        }
+
         template<typename T>
         node* alloc_node(T&& in_value) {
             node* new_node = m_buffer_head.load(std::memory_order_consume);
             exponential_backoff bckoff;
             while(true){
-                if(new_node != m_tail){
-                    if(m_buffer_head.compare_exchange_strong(new_node, new_node->next, 
+                if(new_node != m_tail.load(std::memory_order_acquire)){
+                    if(m_buffer_head.compare_exchange_strong(new_node, new_node->next.load(std::memory_order_acquire),
                             std::memory_order_release, std::memory_order_relaxed)) {
                         new_node->value = std::forward<T>(in_value);
-                        new_node->next = nullptr;
+                        new_node->next.store(nullptr, std::memory_order_relaxed);
                         break;
                     }
                     bckoff();
                 } else {
-                    new_node = new node(std::forward<T>(in_value));
+                    new_node = create_node(std::forward<T>(in_value));
                     break;
                 }
             }
@@ -103,7 +152,8 @@ namespace hope::threading {
 
         // consumer part 
         // accessed mainly by consumer, infrequently be producer 
-        node* m_tail = nullptr; // tail of the queue 
+        std::atomic<node*> m_tail = nullptr; // tail of the queue 
+        [[no_unique_address]] node_allocator_t m_allocator;
 
         // cache line size on modern x86 processors (in bytes) 
         constexpr static std::size_t CacheLineSize = 64;
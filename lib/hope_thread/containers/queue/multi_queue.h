@@ -0,0 +1,175 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hope_thread/foundation.h"
+#include "hope_thread/synchronization/spinlock.h"
+
+namespace hope::threading {
+
+    // relaxed concurrent priority queue (MultiQueue, Rihani et al.): c * threads sequential heaps,
+    // push goes to a random heap, pop takes the better of the tops of two random heaps;
+    // a heap is never waited for, a locked one is just replaced by another random pick;
+    // the order is the same as in std::priority_queue (the greatest according to TCompare first),
+    // but it is relaxed: the popped item is one of the best ones with high probability, not necessarily the best
+    template<typename TPriority, typename TValue, typename TCompare = std::less<TPriority>>
+    class multi_queue final {
+        static_assert(std::is_trivially_copyable_v<TPriority>, "the top priority of each heap is cached in an atomic");
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(multi_queue)
+
+        explicit multi_queue(std::size_t threads = std::thread::hardware_concurrency(), std::size_t c = 2,
+            TCompare compare = TCompare{ })
+            : m_heaps_count(std::max<std::size_t>(std::max<std::size_t>(threads, 1) * c, 2))
+            , m_heaps(std::make_unique<heap[]>(m_heaps_count))
+            , m_compare(std::move(compare)) { }
+
+        ~multi_queue() = default;
+
+        template<typename TVal>
+        void push(const TPriority& priority, TVal&& value) {
+            for (;;) {
+                auto&& h = m_heaps[random_index()];
+                if (!h.lock.try_lock())
+                    continue;
+
+                h.entries.push_back(entry{ priority, std::forward<TVal>(value) });
+                std::push_heap(h.entries.begin(), h.entries.end(), entry_compare{ m_compare });
+                publish_top(h);
+                h.lock.unlock();
+                return;
+            }
+        }
+
+        // fails only if all the heaps were seen empty
+        bool try_pop(TPriority& priority, TValue& value) {
+            for (std::size_t attempt{ 0 }; attempt < m_heaps_count; ++attempt) {
+                auto first = random_index();
+                auto second = random_index();
+                if (first == second)
+                    second = (second + 1) % m_heaps_count;
+
+                auto* h = better(&m_heaps[first], &m_heaps[second]);
+                if (h == nullptr || !h->lock.try_lock())
+                    continue;
+
+                const bool popped = pop_locked(*h, priority, value);
+                h->lock.unlock();
+                if (popped)
+                    return true;
+            }
+
+            // the random picks kept hitting empty or busy heaps, do the honest scan
+            for (std::size_t i{ 0 }; i < m_heaps_count; ++i) {
+                auto&& h = m_heaps[i];
+                if (h.size.load(std::memory_order_acquire) == 0)
+                    continue;
+
+                h.lock.lock();
+                const bool popped = pop_locked(h, priority, value);
+                h.lock.unlock();
+                if (popped)
+                    return true;
+            }
+            return false;
+        }
+
+        bool try_pop(TValue& value) {
+            TPriority priority;
+            return try_pop(priority, value);
+        }
+
+        // approximate
+        std::size_t size() const noexcept {
+            std::size_t total{ 0 };
+            for (std::size_t i{ 0 }; i < m_heaps_count; ++i)
+                total += m_heaps[i].size.load(std::memory_order_relaxed);
+            return total;
+        }
+
+        std::size_t heaps_count() const noexcept {
+            return m_heaps_count;
+        }
+
+    private:
+        struct entry final {
+            TPriority priority;
+            TValue value;
+        };
+
+        struct entry_compare final {
+            bool operator()(const entry& lhs, const entry& rhs) const {
+                return compare(lhs.priority, rhs.priority);
+            }
+
+            const TCompare& compare;
+        };
+
+        struct alignas(CACHE_LINE_SIZE) heap final {
+            spinlock lock;
+            // read without the lock by the poppers to choose between two heaps
+            std::atomic<std::size_t> size{ 0 };
+            std::atomic<TPriority> top{ };
+            std::vector<entry> entries;
+        };
+
+        // the heap with the better top, nullptr if both are empty
+        heap* better(heap* lhs, heap* rhs) const {
+            const bool lhs_empty = lhs->size.load(std::memory_order_acquire) == 0;
+            const bool rhs_empty = rhs->size.load(std::memory_order_acquire) == 0;
+            if (lhs_empty || rhs_empty)
+                return lhs_empty ? (rhs_empty ? nullptr : rhs) : lhs;
+
+            return m_compare(lhs->top.load(std::memory_order_relaxed), rhs->top.load(std::memory_order_relaxed)) ? rhs : lhs;
+        }
+
+        bool pop_locked(heap& h, TPriority& priority, TValue& value) {
+            if (h.entries.empty())
+                return false;
+
+            std::pop_heap(h.entries.begin(), h.entries.end(), entry_compare{ m_compare });
+            auto&& popped = h.entries.back();
+            priority = popped.priority;
+            value = std::move(popped.value);
+            h.entries.pop_back();
+            publish_top(h);
+            return true;
+        }
+
+        static void publish_top(heap& h) noexcept {
+            if (!h.entries.empty())
+                h.top.store(h.entries.front().priority, std::memory_order_relaxed);
+            h.size.store(h.entries.size(), std::memory_order_release);
+        }
+
+        // xorshift64*, one state per thread
+        std::size_t random_index() const noexcept {
+            thread_local uint64_t state = std::hash<std::thread::id>{ }(std::this_thread::get_id()) | 1;
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return (std::size_t)((state * 0x2545F4914F6CDD1DULL) >> 32) % m_heaps_count;
+        }
+
+        const std::size_t m_heaps_count;
+        std::unique_ptr<heap[]> m_heaps;
+        TCompare m_compare;
+    };
+
+}
@@ -0,0 +1,216 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "hope_thread/synchronization/sequence_barrier.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // several processing stages over one pre-allocated ring, the entries are never copied between the stages:
+    // the producer publishes an entry, every stage processes it in place once all of its upstream stages
+    // are done with it, the producer reuses the slot once all the terminal stages (nobody depends on them)
+    // are done with it; every stage keeps its own sequence, so the graph might be a chain
+    //     parse -> enrich -> persist
+    // or a diamond, where the stages without a dependency on each other run in parallel
+    //     decode -> { journal, replicate } -> commit
+    // (parallel stages get the same entry at the same time, they must not write the same fields);
+    // every stage is driven by a single thread, the producer is a single thread as well
+    //     pipeline_ring<order, 1024>::builder b;
+    //     auto parse = b.add_stage();
+    //     auto enrich = b.add_stage({ parse });
+    //     auto persist = b.add_stage({ enrich });
+    //     auto ring = b.build();
+    //     ring->publish([&](order& o) { o = ...; });                           // producer thread
+    //     ring->get_stage(enrich).wait_and_process([](order& o) { ... });      // the thread of the stage
+    template<typename T, std::size_t Size, typename TWaitStrategy = yielding_wait>
+    class pipeline_ring final {
+        static_assert(Size > 1, "Size must be greater than one");
+        static_assert((Size & (Size - 1)) == 0, "Size must be pow of 2");
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(pipeline_ring)
+
+        using stage_id = std::size_t;
+
+        // the stages are added in the topological order: a stage might depend on the added ones only,
+        // so the graph has no cycles by construction
+        class builder final {
+        public:
+            stage_id add_stage(std::initializer_list<stage_id> upstream = { }) {
+                for (auto id : upstream) {
+                    assert(id < m_upstream.size() && "the upstream stage has to be added first");
+                    (void)id;
+                }
+                m_upstream.emplace_back(upstream);
+                return m_upstream.size() - 1;
+            }
+
+            std::unique_ptr<pipeline_ring> build() const {
+                assert(!m_upstream.empty() && "the pipeline needs at least one stage");
+                return std::unique_ptr<pipeline_ring>(new pipeline_ring(m_upstream));
+            }
+
+        private:
+            std::vector<std::vector<stage_id>> m_upstream;
+        };
+
+        class alignas(CACHE_LINE_SIZE) stage final {
+        public:
+            HOPE_THREADING_CONSTRUCTABLE_ONLY(stage)
+
+            stage() = default;
+            ~stage() = default;
+
+            // hands up to max_count entries, all of the upstream stages are done with, to f(T&) in place,
+            // the entries go downstream at once after the whole batch
+            template<typename F>
+            std::size_t process(F&& f, std::size_t max_count = Size) {
+                return process_ready(f, available(), max_count);
+            }
+
+            // waits (with the wait strategy of the ring) until at least one entry is ready
+            template<typename F>
+            std::size_t wait_and_process(F&& f, std::size_t max_count = Size) {
+                return process_ready(f, wait_for_all(m_ring->m_wait, m_upstream, m_position + 1), max_count);
+            }
+
+            // count of entries this stage has processed so far
+            std::size_t sequence() const noexcept {
+                return m_sequence.value.load(std::memory_order_acquire);
+            }
+
+        private:
+            friend class pipeline_ring;
+
+            template<typename F>
+            std::size_t process_ready(F& f, std::size_t ready, std::size_t max_count) {
+                const auto count = std::min(ready - m_position, max_count);
+                if (count == 0)
+                    return 0;
+                for (std::size_t i{ 0 }; i < count; ++i)
+                    f(m_ring->m_buffer[(m_position + i) & (Size - 1)]);
+                m_position += count;
+                m_sequence.value.store(m_position, std::memory_order_release);
+                m_ring->m_wait.notify(m_sequence.value);
+                return count;
+            }
+
+            // the lowest of the upstream sequences, a stage without the upstream gates on the producer
+            std::size_t available() const noexcept {
+                auto result = SIZE_MAX;
+                for (auto* sequence : m_upstream)
+                    result = std::min(result, sequence->load(std::memory_order_acquire));
+                return result;
+            }
+
+            padded_sequence m_sequence;
+
+            // owner only
+            alignas(CACHE_LINE_SIZE) std::size_t m_position{ 0 };
+            std::vector<const std::atomic<std::size_t>*> m_upstream;
+            pipeline_ring* m_ring{ nullptr };
+        };
+
+        ~pipeline_ring() = default;
+
+        stage& get_stage(stage_id id) noexcept {
+            assert(id < m_stages_count);
+            return m_stages[id];
+        }
+
+        std::size_t stages_count() const noexcept {
+            return m_stages_count;
+        }
+
+        // producer only, f(T&) fills the entry in place; false if the ring is full
+        template<typename F>
+        bool try_publish(F&& f) {
+            if (!has_room())
+                return false;
+            commit(f);
+            return true;
+        }
+
+        // waits (with the wait strategy of the ring) for the terminal stages if the ring is full
+        template<typename F>
+        void publish(F&& f) {
+            if (!has_room())
+                m_gating_cache = wait_for_all(m_wait, m_terminal, m_next - Size + 1);
+            commit(f);
+        }
+
+        constexpr static std::size_t capacity() noexcept {
+            return Size;
+        }
+
+    private:
+        explicit pipeline_ring(const std::vector<std::vector<stage_id>>& upstream)
+            : m_stages(std::make_unique<stage[]>(upstream.size()))
+            , m_stages_count(upstream.size()) {
+            std::vector<bool> has_downstream(upstream.size(), false);
+            for (std::size_t i{ 0 }; i < upstream.size(); ++i) {
+                auto&& s = m_stages[i];
+                s.m_ring = this;
+                for (auto id : upstream[i]) {
+                    s.m_upstream.push_back(&m_stages[id].m_sequence.value);
+                    has_downstream[id] = true;
+                }
+                if (s.m_upstream.empty())
+                    s.m_upstream.push_back(&m_cursor.value);
+            }
+            for (std::size_t i{ 0 }; i < upstream.size(); ++i) {
+                if (!has_downstream[i])
+                    m_terminal.push_back(&m_stages[i].m_sequence.value);
+            }
+        }
+
+        template<typename F>
+        void commit(F& f) {
+            f(m_buffer[m_next & (Size - 1)]);
+            ++m_next;
+            m_cursor.value.store(m_next, std::memory_order_release);
+            m_wait.notify(m_cursor.value);
+        }
+
+        // the terminal stages are looked at only when the cached minimum says the ring is full
+        bool has_room() noexcept {
+            if (m_next - m_gating_cache < Size)
+                return true;
+            auto lowest = SIZE_MAX;
+            for (auto* sequence : m_terminal)
+                lowest = std::min(lowest, sequence->load(std::memory_order_acquire));
+            m_gating_cache = lowest;
+            return m_next - m_gating_cache < Size;
+        }
+
+        // published by the producer, read by the stages without the upstream
+        padded_sequence m_cursor;
+
+        // producer only
+        alignas(CACHE_LINE_SIZE) std::size_t m_next{ 0 };
+        std::size_t m_gating_cache{ 0 };
+        std::vector<const std::atomic<std::size_t>*> m_terminal;
+        [[no_unique_address]] TWaitStrategy m_wait;
+
+        std::unique_ptr<stage[]> m_stages;
+        const std::size_t m_stages_count;
+
+        alignas(CACHE_LINE_SIZE) std::array<T, Size> m_buffer{ };
+    };
+
+}
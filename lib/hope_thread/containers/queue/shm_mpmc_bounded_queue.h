@@ -0,0 +1,145 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // the same algorithm as mpmc_bounded_queue, but the whole queue is one position independent block of memory:
+    // the header (capacity and both positions) is followed by the cells right in the same block, the cells are
+    // addressed relative to the header, so the block might be mapped at the different addresses in the different
+    // processes (platform::shared_memory_segment); the capacity is chosen at runtime and stored in the header
+    //     auto* q = shm_mpmc_bounded_queue<job>::create(segment.data, 1024);   // the process owning the segment
+    //     auto* q = shm_mpmc_bounded_queue<job>::attach(segment.data);         // every worker process
+    // the items are copied between the processes byte by byte, so they have to be trivially copyable
+    template<typename TItem>
+    class alignas(CACHE_LINE_SIZE) shm_mpmc_bounded_queue final {
+        static_assert(std::is_trivially_copyable_v<TItem>, "TItem has to be trivially copyable to be shared between processes");
+        static_assert(std::atomic<std::size_t>::is_always_lock_free, "the positions have to be lock free to be shared between processes");
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(shm_mpmc_bounded_queue)
+
+        // bytes the block of a queue of the given capacity occupies
+        constexpr static std::size_t required_size(std::size_t capacity) noexcept {
+            return sizeof(shm_mpmc_bounded_queue) + sizeof(cell) * capacity;
+        }
+
+        // initializes a new queue in the memory, which has to be at least required_size(capacity) bytes
+        // and aligned to the cache line (a mapped segment is page aligned)
+        static shm_mpmc_bounded_queue* create(void* memory, std::size_t capacity) {
+            assert((capacity > 1) && ((capacity & (capacity - 1)) == 0));
+            assert(reinterpret_cast<std::uintptr_t>(memory) % CACHE_LINE_SIZE == 0);
+            auto* queue = new (memory) shm_mpmc_bounded_queue(capacity);
+            auto* cells = queue->cells();
+            for (std::size_t i{ 0 }; i < capacity; ++i)
+                new (&cells[i]) cell(i);
+            return queue;
+        }
+
+        // the queue created by create() in another process (or earlier in this one), the state is not touched
+        static shm_mpmc_bounded_queue* attach(void* memory) noexcept {
+            auto* queue = std::launder(static_cast<shm_mpmc_bounded_queue*>(memory));
+            assert(queue->m_buffer_mask != 0 && ((queue->m_buffer_mask + 1) & queue->m_buffer_mask) == 0);
+            return queue;
+        }
+
+        ~shm_mpmc_bounded_queue() = default;
+
+        bool try_enqueue(const TItem& in_value) {
+            cell* pushed;
+            std::size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            for (;;) {
+                pushed = &cell_at(pos);
+                const std::size_t seq = pushed->sequence.load(std::memory_order_acquire);
+                const intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+                if (dif == 0) {
+                    if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed,
+                                                                      std::memory_order_relaxed))
+                        break;
+                } else if (dif < 0) {
+                    return false;
+                } else {
+                    pos = m_enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            pushed->item = in_value;
+            pushed->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_dequeue(TItem& out_value) {
+            cell* popped;
+            std::size_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            for (;;) {
+                popped = &cell_at(pos);
+                const std::size_t seq = popped->sequence.load(std::memory_order_acquire);
+                const intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+                if (dif == 0) {
+                    if (m_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed,
+                                                                      std::memory_order_relaxed))
+                        break;
+                } else if (dif < 0) {
+                    return false;
+                } else {
+                    pos = m_dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            out_value = popped->item;
+            popped->sequence.store(pos + m_buffer_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::size_t capacity() const noexcept {
+            return m_buffer_mask + 1;
+        }
+
+        // approximate, the positions move while they are read
+        std::size_t size_approx() const noexcept {
+            const auto dequeued = m_dequeue_pos.load(std::memory_order_relaxed);
+            const auto enqueued = m_enqueue_pos.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+    private:
+        struct alignas(CACHE_LINE_SIZE) cell final {
+            explicit cell(std::size_t in_sequence) noexcept
+                : sequence(in_sequence) { }
+
+            std::atomic<std::size_t> sequence;
+            TItem item{ };
+        };
+
+        explicit shm_mpmc_bounded_queue(std::size_t capacity) noexcept
+            : m_buffer_mask(capacity - 1) { }
+
+        // the cells follow the header, the address is computed from this, never stored
+        cell* cells() const noexcept {
+            return std::launder(reinterpret_cast<cell*>(
+                const_cast<unsigned char*>(reinterpret_cast<const unsigned char*>(this)) + sizeof(shm_mpmc_bounded_queue)));
+        }
+
+        cell& cell_at(std::size_t pos) const noexcept {
+            return cells()[pos & m_buffer_mask];
+        }
+
+        const std::size_t m_buffer_mask;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_enqueue_pos{ 0 };
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_dequeue_pos{ 0 };
+    };
+
+}
@@ -10,15 +10,24 @@
 
 #include <atomic>
 #include <array>
+#include <cstring>
+#include <type_traits>
 
 #include "hope_thread/foundation.h"
 
 namespace hope::threading {
 
-    template<typename T, std::size_t Size>
+    enum class overrun_policy : uint8_t {
+        ignore, // the producer laps slow consumers silently, a lapped consumer may read a torn message
+        detect  // every slot is stamped, a lapped consumer skips to the oldest valid message
+    };
+
+    template<typename T, std::size_t Size, overrun_policy policy = overrun_policy::ignore>
     class alignas(CACHE_LINE_SIZE) spmc_bounded_message_queue final {
         static_assert(Size > 0, "Size must be greater than zero");
         static_assert((Size & (Size - 1)) == 0, "Size must be pow of 2");
+        static_assert(policy == overrun_policy::ignore || std::is_trivially_copyable_v<T>,
+            "overrun detection copies the message out of the slot, T must be trivially copyable");
     public:
         ~spmc_bounded_message_queue() = default;
         spmc_bounded_message_queue() = default;
@@ -30,23 +39,92 @@ namespace hope::threading {
             }
 
             bool try_dequeue(T& data) {
-                auto writer_pos = m_queue_impl->m_writer_pos.load(std::memory_order_acquire);
-                if (writer_pos == m_local_read_position) {
-                    return false;
+                if constexpr (policy == overrun_policy::detect) {
+                    return try_dequeue_checked(data);
+                } else {
+                    auto writer_pos = m_queue_impl->m_writer_pos.load(std::memory_order_acquire);
+                    if (writer_pos == m_local_read_position) {
+                        return false;
+                    }
+                    auto peak_msg = m_local_read_position & (Size - 1);
+                    data = m_queue_impl->m_buffer[peak_msg];
+                    ++m_local_read_position;
+                    return true;
                 }
-                auto peak_msg = m_local_read_position & (Size - 1);
-                data = m_queue_impl->m_buffer[peak_msg];
-                ++m_local_read_position;
-                return true;
             }
+
+            // count of messages this consumer lost because the producer lapped it
+            std::size_t overrun_count() const noexcept {
+                return m_overrun_count;
+            }
+
         private:
+            bool try_dequeue_checked(T& data) {
+                for (;;) {
+                    const auto writer_pos = m_queue_impl->m_writer_pos.load(std::memory_order_acquire);
+                    if (writer_pos == m_local_read_position) {
+                        return false;
+                    }
+                    // the ring holds the last Size messages only
+                    if (writer_pos - m_local_read_position > Size) {
+                        skip_to(writer_pos - Size);
+                    }
+
+                    auto&& slot = m_queue_impl->m_buffer[m_local_read_position & (Size - 1)];
+                    const auto stamp = slot.stamp.load(std::memory_order_acquire);
+                    if (stamp != written_stamp(m_local_read_position)) {
+                        on_lapped(stamp);
+                        continue;
+                    }
+
+                    T copy;
+                    std::memcpy(&copy, &slot.value, sizeof(T));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    const auto validation = slot.stamp.load(std::memory_order_relaxed);
+                    if (validation != stamp) {
+                        // the producer started to overwrite the slot while we were copying it
+                        on_lapped(validation);
+                        continue;
+                    }
+
+                    data = copy;
+                    ++m_local_read_position;
+                    return true;
+                }
+            }
+
+            // the slot is taken by the message at position (stamp - 1) / 2 (being written or written),
+            // the oldest message which still might be valid directly follows the previous lap of it
+            void on_lapped(std::size_t stamp) noexcept {
+                const auto position = (stamp - 1) / 2;
+                skip_to(position - Size + 1);
+            }
+
+            void skip_to(std::size_t position) noexcept {
+                if (position > m_local_read_position) {
+                    m_overrun_count += position - m_local_read_position;
+                    m_local_read_position = position;
+                }
+            }
+
             std::size_t m_local_read_position{ 0 };
+            std::size_t m_overrun_count{ 0 };
             spmc_bounded_message_queue* m_queue_impl{ nullptr };
         };
 
+        // never blocks and never waits for the consumers
         bool try_enqueue(const T& item) {
             auto write_pos = m_writer_pos.load(std::memory_order_relaxed);
-            m_buffer[write_pos & (Size - 1)] = item;
+            if constexpr (policy == overrun_policy::detect) {
+                auto&& slot = m_buffer[write_pos & (Size - 1)];
+                slot.stamp.store(written_stamp(write_pos) - 1, std::memory_order_relaxed);
+                // the odd stamp has to be visible before any byte of the new message
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.value = item;
+                slot.stamp.store(written_stamp(write_pos), std::memory_order_release);
+            } else {
+                m_buffer[write_pos & (Size - 1)] = item;
+            }
             m_writer_pos.store(write_pos + 1, std::memory_order_release);
             return true;
         }
@@ -56,6 +134,18 @@ namespace hope::threading {
         }
 
     private:
+        // seqlock-like stamp: odd while the message at the position is being written, even once it is done,
+        // zero means the slot was never written
+        constexpr static std::size_t written_stamp(std::size_t position) noexcept {
+            return 2 * position + 2;
+        }
+
+        struct stamped_slot final {
+            std::atomic<std::size_t> stamp{ 0 };
+            T value;
+        };
+
+        using slot_t = std::conditional_t<policy == overrun_policy::detect, stamped_slot, T>;
 
         // advanced once writer writes something, 1 element ahead of reader
         std::atomic<std::size_t> m_writer_pos{ };
@@ -63,9 +153,9 @@ namespace hope::threading {
         // not pretty sure if we need it
         char pad[CACHE_LINE_SIZE]{ };
 
-        std::array<T, Size> m_buffer;
+        std::array<slot_t, Size> m_buffer;
 
         friend struct consumer;
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,253 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+#include "hope_thread/synchronization/sequence_barrier.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // Disruptor-like broadcast ring: every consumer sees every message, unlike spmc_bounded_message_queue
+    // the producer never laps a consumer, it gates on the slowest registered one;
+    // the minimum of the consumer sequences is cached by the producer and recomputed only
+    // when the cached value says the ring is full, so in the steady state publishing touches
+    // the producer cache lines only;
+    // consumers are expected to be created before the producer starts, a consumer starts at the current cursor
+    template<typename T, std::size_t Size, typename TWaitStrategy = yielding_wait, std::size_t MaxConsumers = 16>
+    class alignas(CACHE_LINE_SIZE) spmc_broadcast_queue final {
+        static_assert(Size > 1, "Size must be greater than one");
+        static_assert((Size & (Size - 1)) == 0, "Size must be pow of 2");
+        static_assert(MaxConsumers > 0, "MaxConsumers must be greater than zero");
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(spmc_broadcast_queue)
+
+        spmc_broadcast_queue() = default;
+        ~spmc_broadcast_queue() = default;
+
+        class consumer final {
+        public:
+            HOPE_THREADING_NON_COPYABLE(consumer);
+
+            consumer(consumer&& other) noexcept
+                : m_queue_impl(std::exchange(other.m_queue_impl, nullptr))
+                , m_slot(other.m_slot)
+                , m_position(other.m_position) { }
+
+            consumer& operator=(consumer&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    m_queue_impl = std::exchange(other.m_queue_impl, nullptr);
+                    m_slot = other.m_slot;
+                    m_position = other.m_position;
+                }
+                return *this;
+            }
+
+            ~consumer() {
+                release();
+            }
+
+            // false if the consumer could not be registered (all the slots are taken)
+            bool valid() const noexcept {
+                return m_queue_impl != nullptr;
+            }
+
+            bool try_dequeue(T& data) {
+                return consume([&data](const T& item) { data = item; }, 1) == 1;
+            }
+
+            void dequeue(T& data) {
+                wait_for(1);
+                (void)try_dequeue(data);
+            }
+
+            // hands up to max_count published messages to f(const T&) right in the ring,
+            // the slots are given back to the producer once, after the whole batch
+            template<typename F>
+            std::size_t consume(F&& f, std::size_t max_count = Size) {
+                const auto available = m_queue_impl->m_cursor.value.load(std::memory_order_acquire) - m_position;
+                const auto count = std::min(available, max_count);
+                if (count == 0)
+                    return 0;
+
+                for (std::size_t i{ 0 }; i < count; ++i)
+                    f(std::as_const(m_queue_impl->m_buffer[(m_position + i) & (Size - 1)]));
+                m_position += count;
+                auto&& sequence = m_queue_impl->m_consumers[m_slot].sequence.value;
+                sequence.store(m_position, std::memory_order_release);
+                m_queue_impl->m_wait.notify(sequence);
+                return count;
+            }
+
+            // waits (with the wait strategy of the queue) until at least min_count messages are published
+            template<typename F>
+            std::size_t wait_and_consume(F&& f, std::size_t max_count = Size, std::size_t min_count = 1) {
+                wait_for(std::min(min_count, max_count));
+                return consume(std::forward<F>(f), max_count);
+            }
+
+            // count of published messages this consumer did not read yet
+            std::size_t lag() const noexcept {
+                return m_queue_impl->m_cursor.value.load(std::memory_order_acquire) - m_position;
+            }
+
+        private:
+            friend class spmc_broadcast_queue;
+
+            consumer(spmc_broadcast_queue* in_impl, std::size_t slot) noexcept
+                : m_queue_impl(in_impl)
+                , m_slot(slot) {
+                if (m_queue_impl != nullptr)
+                    m_position = m_queue_impl->m_consumers[m_slot].sequence.value.load(std::memory_order_relaxed);
+            }
+
+            void wait_for(std::size_t count) {
+                auto&& cursor = m_queue_impl->m_cursor.value;
+                m_queue_impl->m_wait.wait(cursor, [&] {
+                    return cursor.load(std::memory_order_acquire) - m_position >= count;
+                });
+            }
+
+            // the slot stops gating the producer, the sequence is bumped to wake up a parked producer
+            void release() noexcept {
+                if (m_queue_impl == nullptr)
+                    return;
+                auto&& slot = m_queue_impl->m_consumers[m_slot];
+                slot.active.store(false, std::memory_order_release);
+                slot.sequence.value.fetch_add(1, std::memory_order_release);
+                m_queue_impl->m_wait.notify(slot.sequence.value);
+                slot.taken.store(false, std::memory_order_release);
+                m_queue_impl = nullptr;
+            }
+
+            spmc_broadcast_queue* m_queue_impl{ nullptr };
+            std::size_t m_slot{ 0 };
+            std::size_t m_position{ 0 };
+        };
+
+        // the returned consumer is not valid() if MaxConsumers consumers are registered already
+        consumer create_consumer() {
+            for (std::size_t i{ 0 }; i < MaxConsumers; ++i) {
+                auto&& slot = m_consumers[i];
+                bool expected = false;
+                if (slot.taken.load(std::memory_order_relaxed)
+                    || !slot.taken.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    continue;
+                slot.sequence.value.store(m_cursor.value.load(std::memory_order_acquire), std::memory_order_relaxed);
+                slot.active.store(true, std::memory_order_release);
+                return consumer{ this, i };
+            }
+            return consumer{ nullptr, 0 };
+        }
+
+        // producer only; false if the slowest consumer is still Size messages behind
+        bool try_enqueue(const T& item) {
+            return try_publish([&item](T& slot) { slot = item; });
+        }
+
+        void enqueue(const T& item) {
+            publish([&item](T& slot) { slot = item; });
+        }
+
+        // f(T&) fills the slot in place
+        template<typename F>
+        bool try_publish(F&& f) {
+            if (!has_room())
+                return false;
+            commit(std::forward<F>(f));
+            return true;
+        }
+
+        // waits (with the wait strategy of the queue) for the slowest consumer if the ring is full
+        template<typename F>
+        void publish(F&& f) {
+            while (!has_room()) {
+                // several consumers might share the lowest sequence, so once the chosen one moves
+                // the slowest is chosen again
+                auto&& slowest = slowest_sequence();
+                const auto seen = slowest.load(std::memory_order_acquire);
+                m_wait.wait(slowest, [&] {
+                    return slowest.load(std::memory_order_acquire) != seen || has_room();
+                });
+            }
+            commit(std::forward<F>(f));
+        }
+
+        constexpr static std::size_t capacity() noexcept {
+            return Size;
+        }
+
+    private:
+        struct alignas(CACHE_LINE_SIZE) consumer_slot final {
+            padded_sequence sequence;
+            std::atomic<bool> active{ false };
+            std::atomic<bool> taken{ false };
+        };
+
+        template<typename F>
+        void commit(F&& f) {
+            f(m_buffer[m_next & (Size - 1)]);
+            ++m_next;
+            m_cursor.value.store(m_next, std::memory_order_release);
+            m_wait.notify(m_cursor.value);
+        }
+
+        bool has_room() noexcept {
+            if (m_next - m_gating_cache < Size)
+                return true;
+            m_gating_cache = min_sequence();
+            return m_next - m_gating_cache < Size;
+        }
+
+        // without consumers nothing gates the producer
+        std::size_t min_sequence() const noexcept {
+            auto result = m_next;
+            for (auto&& slot : m_consumers) {
+                if (slot.active.load(std::memory_order_acquire))
+                    result = std::min(result, slot.sequence.value.load(std::memory_order_acquire));
+            }
+            return result;
+        }
+
+        std::atomic<std::size_t>& slowest_sequence() noexcept {
+            auto* result = &m_cursor.value;
+            auto lowest = m_next;
+            for (auto&& slot : m_consumers) {
+                const auto sequence = slot.sequence.value.load(std::memory_order_acquire);
+                if (slot.active.load(std::memory_order_acquire) && sequence <= lowest) {
+                    lowest = sequence;
+                    result = &slot.sequence.value;
+                }
+            }
+            return *result;
+        }
+
+        // published by the producer, read by the consumers
+        padded_sequence m_cursor;
+
+        // producer only
+        alignas(CACHE_LINE_SIZE) std::size_t m_next{ 0 };
+        std::size_t m_gating_cache{ 0 };
+        [[no_unique_address]] TWaitStrategy m_wait;
+
+        std::array<consumer_slot, MaxConsumers> m_consumers;
+
+        alignas(CACHE_LINE_SIZE) std::array<T, Size> m_buffer;
+
+        friend class consumer;
+    };
+
+}
@@ -8,15 +8,24 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
+#include <span>
 #include <vector>
 #include <atomic>
+#include <type_traits>
 
+#include "hope_thread/core/instrumentation.h"
 #include "hope_thread/foundation.h"
 
 namespace hope::threading {
 
-    template<typename T>
+    // FastForward-like ring: each side keeps a private copy of the other side's index
+    // and reloads the shared one only when the copy says the ring is full (empty),
+    // so in the steady state producer and consumer do not touch each other's cache lines;
+    // TInstrumentation: see core/instrumentation.h, nothing is recorded by default
+    template<typename T, typename TInstrumentation = default_queue_instrumentation>
     class spsc_bounded_queue final {
     public:
 
@@ -25,55 +34,130 @@ namespace hope::threading {
 
         explicit spsc_bounded_queue(std::size_t buffer_size = 64)
             : m_buffer_mask(buffer_size - 1)
-            , m_buffer_size(buffer_size){
+            , m_buffer_size(buffer_size)
+            , m_buffer(std::make_unique<T[]>(buffer_size)) {
             assert((buffer_size > 1) && ((buffer_size & (buffer_size - 1)) == 0));
-            m_buffer.resize(buffer_size);
+            if constexpr (TInstrumentation::enabled)
+                m_stamps.resize(buffer_size);
         }
 
         template<typename TVal>
         bool try_enqueue(TVal&& v) {
             const auto cur_head = m_head.load(std::memory_order_relaxed);
+            if (cur_head - m_tail_cache == m_buffer_size) {
+                m_tail_cache = m_tail.load(std::memory_order_acquire);
+                if (cur_head - m_tail_cache == m_buffer_size) {
+                    m_instrumentation.on_full();
+                    return false;
+                }
+            }
+
+            m_buffer[cur_head & m_buffer_mask] = std::forward<TVal>(v);
+            stamp(cur_head, 1);
+            m_head.store(cur_head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_dequeue(T& v) {
             const auto cur_tail = m_tail.load(std::memory_order_relaxed);
+            if (cur_tail == m_head_cache) {
+                m_head_cache = m_head.load(std::memory_order_acquire);
+                if (cur_tail == m_head_cache) {
+                    m_instrumentation.on_empty();
+                    return false;
+                }
+            }
+
+            v = std::move(m_buffer[cur_tail & m_buffer_mask]);
+            unstamp(cur_tail, 1);
+            m_tail.store(cur_tail + 1, std::memory_order_release);
+            return true;
+        }
 
-            if (cur_head - cur_tail > m_buffer_size)
-                return false;
+        // producer side: contiguous free slots starting at the write position (might be empty),
+        // the span ends at the end of the ring, so it could be shorter than the whole free space;
+        // fill some prefix of it and publish with commit(n)
+        std::span<T> write_span() {
+            const auto cur_head = m_head.load(std::memory_order_relaxed);
+            const auto index = cur_head & m_buffer_mask;
+            const auto till_end = m_buffer_size - index;
+            if (m_buffer_size - (cur_head - m_tail_cache) < till_end)
+                m_tail_cache = m_tail.load(std::memory_order_acquire);
 
-            const auto actual_index = cur_head & m_buffer_mask;
-            m_buffer[actual_index].value = std::forward<TVal>(v);
-            m_head.fetch_add(cur_head + 1, std::memory_order_release);
-            return true;
+            const auto free = m_buffer_size - (cur_head - m_tail_cache);
+            return { m_buffer.get() + index, std::min(free, till_end) };
         }
 
-        bool try_dequeue(T& v) {
+        void commit(std::size_t count) {
             const auto cur_head = m_head.load(std::memory_order_relaxed);
+            assert(cur_head + count - m_tail_cache <= m_buffer_size);
+            stamp(cur_head, count);
+            m_head.store(cur_head + count, std::memory_order_release);
+        }
+
+        // consumer side: contiguous ready items starting at the read position (might be empty),
+        // consume some prefix of it and give the slots back with release(n)
+        std::span<T> read_span() {
             const auto cur_tail = m_tail.load(std::memory_order_relaxed);
-            if (cur_head == cur_tail)
-                return false;
+            const auto index = cur_tail & m_buffer_mask;
+            const auto till_end = m_buffer_size - index;
+            if (m_head_cache - cur_tail < till_end)
+                m_head_cache = m_head.load(std::memory_order_acquire);
 
-            const auto actual_index = cur_tail & m_buffer_mask;
-            v = std::move(m_buffer[actual_index].value);
-            m_tail.fetch_add(cur_tail + 1, std::memory_order_release);
-            return true;
+            return { m_buffer.get() + index, std::min(m_head_cache - cur_tail, till_end) };
         }
 
-    private:
+        void release(std::size_t count) {
+            const auto cur_tail = m_tail.load(std::memory_order_relaxed);
+            assert(cur_tail + count <= m_head_cache);
+            unstamp(cur_tail, count);
+            m_tail.store(cur_tail + count, std::memory_order_release);
+        }
 
-        struct alignas(64) node final {
-          T value;
-        };
+        std::size_t capacity() const noexcept {
+            return m_buffer_size;
+        }
 
-        const std::size_t m_buffer_mask;
-        const std::size_t m_buffer_size;
+        // might be called from any thread at any moment, all zeros unless the queue is instrumented
+        queue_stats stats() const {
+            return m_instrumentation.stats();
+        }
 
-        std::atomic<std::size_t> m_head{ 0 };
+    private:
+        using stamps_t = std::conditional_t<TInstrumentation::enabled,
+            std::vector<typename TInstrumentation::timestamp_t>, typename TInstrumentation::timestamp_t>;
+
+        // the enqueue time of the slot is kept aside of the slot, so the spans still hand out plain T
+        void stamp(std::size_t position, std::size_t count) {
+            if constexpr (TInstrumentation::enabled) {
+                const auto now = m_instrumentation.on_enqueue(count);
+                for (std::size_t i{ 0 }; i < count; ++i)
+                    m_stamps[(position + i) & m_buffer_mask] = now;
+            }
+        }
 
-        const char padding1[64]{ };
+        // the stamps are read before the slots go back to the producer
+        void unstamp(std::size_t position, std::size_t count) {
+            if constexpr (TInstrumentation::enabled) {
+                for (std::size_t i{ 0 }; i < count; ++i)
+                    m_instrumentation.on_dequeue(m_stamps[(position + i) & m_buffer_mask]);
+            }
+        }
 
-        std::atomic<std::size_t> m_tail{ 0 };
+        // producer part
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head{ 0 };
+        std::size_t m_tail_cache{ 0 };
 
-        const char padding2[64]{ };
+        // consumer part
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail{ 0 };
+        std::size_t m_head_cache{ 0 };
 
-        std::vector<node> m_buffer;
+        // read only part, slots are stored contiguously to be handed out as spans (vector<bool> would not be)
+        alignas(CACHE_LINE_SIZE) const std::size_t m_buffer_mask;
+        const std::size_t m_buffer_size;
+        std::unique_ptr<T[]> m_buffer;
+        [[no_unique_address]] stamps_t m_stamps;
+        [[no_unique_address]] TInstrumentation m_instrumentation;
     };
 
-}
\ No newline at end of file
+}
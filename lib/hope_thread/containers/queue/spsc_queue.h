@@ -8,19 +8,22 @@
 
 #pragma once
 
+#include <memory>
+
 #include "hope_thread/synchronization/lcsr.h"
 #include "hope_thread/foundation.h"
 
 namespace hope::threading {
 
-    template<typename T>
+    template<typename T, typename TAllocator = std::allocator<T>>
     class spsc_queue final {
     public:
 
         HOPE_THREADING_CONSTRUCTABLE_ONLY(spsc_queue)
 
-        explicit spsc_queue(std::size_t pre_alloc = 0) {
-            node* n = new node;
+        explicit spsc_queue(std::size_t pre_alloc = 0, const TAllocator& allocator = TAllocator())
+            : m_allocator(allocator) {
+            node* n = create_node();
             m_tail = m_head = m_first = m_tail_copy = n;
 
             // TODO:: rework
@@ -35,7 +38,7 @@ namespace hope::threading {
         ~spsc_queue() {
             for(auto* cur_node = m_first; cur_node != nullptr;) {
                 auto* next = cur_node->next;
-                delete cur_node;
+                destroy_node(cur_node);
                 cur_node = next;
             }
         }
@@ -69,6 +72,26 @@ namespace hope::threading {
             T value;
         };
 
+        using node_allocator_t = typename std::allocator_traits<TAllocator>::template rebind_alloc<node>;
+        using node_traits_t = std::allocator_traits<node_allocator_t>;
+
+        template<typename... Args>
+        node* create_node(Args&&... args) {
+            node* n = node_traits_t::allocate(m_allocator, 1);
+            try {
+                node_traits_t::construct(m_allocator, n, std::forward<Args>(args)...);
+            } catch (...) {
+                node_traits_t::deallocate(m_allocator, n, 1);
+                throw;
+            }
+            return n;
+        }
+
+        void destroy_node(node* n) {
+            node_traits_t::destroy(m_allocator, n);
+            node_traits_t::deallocate(m_allocator, n, 1);
+        }
+
         // consumer part 
         // accessed mainly by consumer, infrequently be producer 
         node* m_tail = nullptr; // tail of the queue 
@@ -85,6 +108,7 @@ namespace hope::threading {
         node* m_head = nullptr; // head of the queue 
         node* m_first = nullptr; // last unused node (tail of node cache) 
         node* m_tail_copy = nullptr; // helper (points somewhere between m_first and m_tail) 
+        [[no_unique_address]] node_allocator_t m_allocator; // producer allocates, nodes are freed only by the destructor
 
         template<typename... Args>
         node* create_from_internal(Args&&... args) {
@@ -97,7 +121,7 @@ namespace hope::threading {
         template<typename... Args>
         node* alloc_node(Args&&... args) {
             // first tries to allocate node from internal node cache, 
-            // if attempt fails, allocates node via ::operator new() 
+            // if attempt fails, allocates node via the allocator
 
             if (m_first != m_tail_copy)
                 return create_from_internal(std::forward<Args>(args)...);
@@ -107,7 +131,7 @@ namespace hope::threading {
             if (m_first != m_tail_copy)
                 return create_from_internal(std::forward<Args>(args)...);
 
-            return new node(std::forward<Args>(args)...);
+            return create_node(std::forward<Args>(args)...);
         }
     };
 
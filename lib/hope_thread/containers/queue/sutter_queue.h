@@ -9,10 +9,13 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
+
+#include "hope_thread/foundation.h"
 
 namespace hope::threading {
 
-template <typename T>
+template <typename T, typename TAllocator = std::allocator<T>>
     class sutter_queue final {
 
         struct node final {
@@ -24,28 +27,32 @@ template <typename T>
 
             node* next{ nullptr };
         };
+
+        using node_allocator_t = typename std::allocator_traits<TAllocator>::template rebind_alloc<node>;
+        using node_traits_t = std::allocator_traits<node_allocator_t>;
     
     public:
 
         HOPE_THREADING_CONSTRUCTABLE_ONLY(sutter_queue)
 
         // This queue must be fully constructed before being used in another thread.
-        sutter_queue() {
-            m_first = m_divider = m_last = new node(T());
+        explicit sutter_queue(const TAllocator& allocator = TAllocator())
+            : m_allocator(allocator) {
+            m_first = m_divider = m_last = create_node(T());
         }
     
         ~sutter_queue() {
             while (m_first != nullptr) {
                 node* temp = m_first;
                 m_first = temp->next;
-                delete temp;
+                destroy_node(temp);
             }
         }
     
         template<typename TVal>
         void enqueue(TVal&& item) {
             auto* last = m_last.load();
-            last->next = new node(std::forward<TVal>(item));
+            last->next = create_node(std::forward<TVal>(item));
     
             produce_impl(last);
         }
@@ -64,6 +71,24 @@ template <typename T>
         }
     
     private:
+        // producer only, both allocation and release of the nodes happen on its side
+        template<typename TVal>
+        node* create_node(TVal&& val) {
+            node* n = node_traits_t::allocate(m_allocator, 1);
+            try {
+                node_traits_t::construct(m_allocator, n, std::forward<TVal>(val));
+            } catch (...) {
+                node_traits_t::deallocate(m_allocator, n, 1);
+                throw;
+            }
+            return n;
+        }
+
+        void destroy_node(node* n) {
+            node_traits_t::destroy(m_allocator, n);
+            node_traits_t::deallocate(m_allocator, n, 1);
+        }
+
         void produce_impl(node* tmp_last) {
             tmp_last = tmp_last->next;
     
@@ -73,7 +98,7 @@ template <typename T>
             while (m_first != div) {
                 node* temp = m_first;
                 m_first = m_first->next;
-                delete temp;
+                destroy_node(temp);
     
                 div = m_divider.load();
             }
@@ -82,6 +107,7 @@ template <typename T>
         constexpr static std::size_t CacheLineSize{ 64 };
 
         node* m_first;    // Producer Only
+        [[no_unique_address]] node_allocator_t m_allocator;    // Producer Only
 
         uint8_t m_cache_padding1[CacheLineSize]{ };
 
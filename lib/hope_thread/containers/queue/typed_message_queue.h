@@ -0,0 +1,144 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "hope_thread/containers/queue/spmc_bounded_non_uniform_queue.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // compile time list of the message types a queue carries, the id of a type is its index in the list
+    template<typename... Ts>
+    struct message_registry final {
+        static_assert(sizeof...(Ts) > 0, "the registry needs at least one message type");
+        static_assert(sizeof...(Ts) <= UINT16_MAX, "the type id is 16 bit wide");
+        static_assert((std::is_trivially_copyable_v<Ts> && ...), "messages are read in place and never destroyed, they have to be trivially copyable");
+
+        constexpr static std::size_t size = sizeof...(Ts);
+
+        template<typename T>
+        constexpr static bool contains = (std::is_same_v<T, Ts> || ...);
+
+        template<typename T>
+        constexpr static uint16_t id_of() noexcept {
+            static_assert(contains<T>, "the type is not registered");
+            uint16_t id{ 0 };
+            (void)((std::is_same_v<T, Ts> ? true : (++id, false)) || ...);
+            return id;
+        }
+
+        // one entry per type, the visitor is called through the table, not through a chain of comparisons
+        template<typename TVisitor>
+        constexpr static std::array<void(*)(const uint8_t*, TVisitor&), sizeof...(Ts)> dispatch_table{
+            [](const uint8_t* message, TVisitor& visitor) {
+                visitor(*std::launder(reinterpret_cast<const Ts*>(message)));
+            }...
+        };
+    };
+
+    // typed layer over spmc_bounded_non_uniform_queue: the payload of a frame is [type id][offset][padding][T],
+    // the message is constructed right in the ring by the producer and handed to the visitor of a consumer
+    // as const T& right in the ring, nothing is copied on either side; the offset keeps T aligned
+    // whatever the position of the frame is;
+    // inherits the semantics of the underlying queue: one producer, consumers never stop it (a lapped
+    // consumer reads garbage), so the ring has to be sized for the slowest consumer
+    //     using registry = message_registry<order, cancel, trade>;
+    //     typed_message_queue<1 << 20, registry> q;
+    //     q.publish<order>(id, price, qty);                  // producer
+    //     auto c = q.create_consumer();
+    //     c.try_visit(overloaded{ [](const order& o) { ... }, [](const cancel& c) { ... }, [](const trade&) { } });
+    template<std::size_t BufferSize, typename TRegistry>
+    class alignas(CACHE_LINE_SIZE) typed_message_queue final {
+        using queue_t = spmc_bounded_non_uniform_queue<BufferSize>;
+
+        struct tag final {
+            uint16_t type_id;
+            uint16_t offset;
+        };
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(typed_message_queue)
+
+        typed_message_queue() = default;
+        ~typed_message_queue() = default;
+
+        class consumer final {
+        public:
+            // passes the next message to visitor(const T&), false if there is nothing to read
+            template<typename TVisitor>
+            bool try_visit(TVisitor&& visitor) {
+                auto read = [&visitor](uint8_t* data, std::size_t) {
+                    tag header;
+                    std::memcpy(&header, data, sizeof(header));
+                    assert(header.type_id < TRegistry::size && "unknown message type");
+                    if (header.type_id < TRegistry::size) {
+                        using visitor_t = std::remove_reference_t<TVisitor>;
+                        TRegistry::template dispatch_table<visitor_t>[header.type_id](data + header.offset, visitor);
+                    }
+                };
+                return m_impl.try_deserialize(read);
+            }
+
+        private:
+            friend class typed_message_queue;
+
+            explicit consumer(typename queue_t::consumer&& impl)
+                : m_impl(std::move(impl)) { }
+
+            typename queue_t::consumer m_impl;
+        };
+
+        // constructs T(args...) right in the ring
+        template<typename T, typename... Args>
+        void publish(Args&&... args) {
+            static_assert(TRegistry::template contains<T>, "the type is not registered");
+            static_assert(payload_size<T>() + sizeof(uint32_t) <= BufferSize, "the message does not fit the buffer");
+            m_queue.seirialize([&](uint8_t* data) {
+                // the address (not the position) is aligned, segments are mapped page aligned in every process
+                const auto address = reinterpret_cast<std::uintptr_t>(data) + sizeof(tag);
+                const auto aligned = (address + alignof(T) - 1) / alignof(T) * alignof(T);
+                const tag header{ TRegistry::template id_of<T>(),
+                    static_cast<uint16_t>(aligned - reinterpret_cast<std::uintptr_t>(data)) };
+                std::memcpy(data, &header, sizeof(header));
+                new (data + header.offset) T{ std::forward<Args>(args)... };
+            }, payload_size<T>());
+        }
+
+        consumer create_consumer() {
+            return consumer{ m_queue.create_consumer() };
+        }
+
+        // worst case padding included, a multiple of 4, so the size word of the next frame never crosses the end of the ring
+        template<typename T>
+        constexpr static std::size_t payload_size() noexcept {
+            return (sizeof(tag) + alignof(T) - 1 + sizeof(T) + 3) / 4 * 4;
+        }
+
+    private:
+        queue_t m_queue;
+    };
+
+    // a visitor made of several lambdas
+    template<typename... Fs>
+    struct overloaded final : Fs... {
+        using Fs::operator()...;
+    };
+
+    template<typename... Fs>
+    overloaded(Fs...) -> overloaded<Fs...>;
+
+}
@@ -0,0 +1,157 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // Chase-Lev deque, memory orders follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al.);
+    // the owner thread pushes and pops at the bottom, any other thread steals from the top;
+    // the ring grows when it is full, old rings are retired and released together with the deque,
+    // since a thief might still read from the ring it loaded before the growth
+    template<typename T>
+    class work_stealing_deque final {
+        static_assert(std::is_trivially_copyable_v<T>, "items are read speculatively by the thieves, T must be trivially copyable");
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(work_stealing_deque)
+
+        explicit work_stealing_deque(std::size_t capacity = 1024) {
+            assert((capacity > 1) && ((capacity & (capacity - 1)) == 0));
+            m_ring.store(new ring((int64_t)capacity), std::memory_order_relaxed);
+        }
+
+        ~work_stealing_deque() {
+            delete m_ring.load(std::memory_order_relaxed);
+            for (auto* retired : m_retired)
+                delete retired;
+        }
+
+        // owner only
+        void push(const T& item) {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed);
+            const auto top = m_top.load(std::memory_order_acquire);
+            auto* cur_ring = m_ring.load(std::memory_order_relaxed);
+            if (bottom - top > cur_ring->mask) {
+                cur_ring = grow(cur_ring, top, bottom);
+            }
+            cur_ring->put(bottom, item);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        // owner only; takes the most recently pushed item
+        bool pop(T& item) {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            auto* cur_ring = m_ring.load(std::memory_order_relaxed);
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                // empty
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            item = cur_ring->get(bottom);
+            if (top == bottom) {
+                // the last item, race with the thieves for it
+                const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                                             std::memory_order_relaxed);
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        // might be called from any thread; takes the oldest item,
+        // fails if the deque is empty or another thread took the item first
+        bool steal(T& item) {
+            auto top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = m_bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+                return false;
+
+            // consume in the paper, acquire is what compilers do for it anyway
+            auto* cur_ring = m_ring.load(std::memory_order_acquire);
+            const T stolen = cur_ring->get(top);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                             std::memory_order_relaxed)) {
+                return false;
+            }
+            item = stolen;
+            return true;
+        }
+
+        // approximate, exact for the owner if there are no thieves
+        std::size_t size() const noexcept {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed);
+            const auto top = m_top.load(std::memory_order_relaxed);
+            return bottom > top ? (std::size_t)(bottom - top) : 0;
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        std::size_t capacity() const noexcept {
+            return (std::size_t)m_ring.load(std::memory_order_relaxed)->capacity;
+        }
+
+    private:
+        struct ring final {
+            explicit ring(int64_t in_capacity)
+                : capacity(in_capacity)
+                , mask(in_capacity - 1)
+                , items(new std::atomic<T>[in_capacity]) { }
+
+            ~ring() {
+                delete[] items;
+            }
+
+            void put(int64_t pos, const T& item) noexcept {
+                items[pos & mask].store(item, std::memory_order_relaxed);
+            }
+
+            T get(int64_t pos) const noexcept {
+                return items[pos & mask].load(std::memory_order_relaxed);
+            }
+
+            const int64_t capacity;
+            const int64_t mask;
+            std::atomic<T>* items;
+        };
+
+        ring* grow(ring* old_ring, int64_t top, int64_t bottom) {
+            auto* new_ring = new ring(old_ring->capacity * 2);
+            for (auto pos = top; pos != bottom; ++pos)
+                new_ring->put(pos, old_ring->get(pos));
+            m_retired.push_back(old_ring);
+            m_ring.store(new_ring, std::memory_order_release);
+            return new_ring;
+        }
+
+        // thieves part
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_top{ 0 };
+
+        // owner part
+        alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_bottom{ 0 };
+        std::atomic<ring*> m_ring{ nullptr };
+        std::vector<ring*> m_retired;
+    };
+
+}
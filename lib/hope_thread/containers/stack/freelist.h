@@ -0,0 +1,85 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "hope_thread/core/tagged_pointer.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // link embedded into the user's object, the object has to derive from it
+    struct freelist_hook {
+        freelist_hook() noexcept = default;
+        freelist_hook(const freelist_hook&) noexcept { }
+        freelist_hook& operator=(const freelist_hook&) noexcept { return *this; }
+
+        // might be read by a racing pop after the object was taken, hence atomic
+        std::atomic<freelist_hook*> freelist_next{ nullptr };
+    };
+
+    // lock-free intrusive stack of caller owned objects (Treiber stack with a tagged head against ABA);
+    // the freelist never frees anything, the objects must stay alive as long as the freelist is used,
+    // which is exactly the case for pooled buffers
+    template<typename T>
+    class freelist final {
+        static_assert(std::is_base_of_v<freelist_hook, T>, "T must derive from freelist_hook");
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(freelist)
+
+        freelist() = default;
+        ~freelist() = default;
+
+        void push(T* item) noexcept {
+            auto* hook = static_cast<freelist_hook*>(item);
+            auto head = m_head.load(std::memory_order_relaxed);
+            for (;;) {
+                hook->freelist_next.store(head.get_ptr(), std::memory_order_relaxed);
+                if (m_head.compare_exchange_weak(head, { hook, head.get_tag() + 1 }, std::memory_order_release))
+                    return;
+            }
+        }
+
+        // pushes the chain first -> ... -> last linked through freelist_next with a single cas
+        void push_chain(T* first, T* last) noexcept {
+            auto* last_hook = static_cast<freelist_hook*>(last);
+            auto head = m_head.load(std::memory_order_relaxed);
+            for (;;) {
+                last_hook->freelist_next.store(head.get_ptr(), std::memory_order_relaxed);
+                if (m_head.compare_exchange_weak(head, { static_cast<freelist_hook*>(first), head.get_tag() + 1 },
+                                                 std::memory_order_release))
+                    return;
+            }
+        }
+
+        T* try_pop() noexcept {
+            auto head = m_head.load(std::memory_order_acquire);
+            for (;;) {
+                auto* hook = head.get_ptr();
+                if (hook == nullptr)
+                    return nullptr;
+                // the tag makes the cas fail if the head was popped and pushed back meanwhile
+                auto* next = hook->freelist_next.load(std::memory_order_relaxed);
+                if (m_head.compare_exchange_weak(head, { next, head.get_tag() + 1 }, std::memory_order_acquire))
+                    return static_cast<T*>(hook);
+            }
+        }
+
+        // not synchronized with anything, a hint only
+        bool empty() const noexcept {
+            return m_head.load(std::memory_order_relaxed).get_ptr() == nullptr;
+        }
+
+    private:
+        alignas(CACHE_LINE_SIZE) atomic_tagged_ptr<freelist_hook> m_head;
+    };
+
+}
@@ -0,0 +1,81 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "hope_thread/containers/stack/freelist.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // lock-free mpmc stack of values; nodes are recycled through the own freelist and released by the destructor only,
+    // so a racing pop never touches freed memory and the tagged heads take care of ABA
+    template<typename T>
+    class treiber_stack final {
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(treiber_stack)
+
+        treiber_stack() = default;
+
+        ~treiber_stack() {
+            while (auto* n = m_items.try_pop()) {
+                n->item()->~T();
+                delete n;
+            }
+            while (auto* n = m_nodes.try_pop())
+                delete n;
+        }
+
+        template<typename... Args>
+        void emplace(Args&&... args) {
+            auto* n = m_nodes.try_pop();
+            if (n == nullptr)
+                n = new node;
+            new (n->storage) T(std::forward<Args>(args)...);
+            m_items.push(n);
+        }
+
+        template<typename TVal>
+        void push(TVal&& value) {
+            emplace(std::forward<TVal>(value));
+        }
+
+        bool try_pop(T& value) {
+            auto* n = m_items.try_pop();
+            if (n == nullptr)
+                return false;
+            auto* item = n->item();
+            value = std::move(*item);
+            item->~T();
+            m_nodes.push(n);
+            return true;
+        }
+
+        // not synchronized with anything, a hint only
+        bool empty() const noexcept {
+            return m_items.empty();
+        }
+
+    private:
+        struct node final : freelist_hook {
+            T* item() noexcept {
+                return std::launder(reinterpret_cast<T*>(storage));
+            }
+
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        freelist<node> m_items;
+        freelist<node> m_nodes;
+    };
+
+}
@@ -0,0 +1,149 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "hope_thread/core/reclamation.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // epoch based reclamation (Fraser): a guard pins the calling thread to the current global epoch,
+    // a node retired in epoch e is freed once the global epoch reaches e + 2, i.e. once every thread
+    // which could see the node has left its critical section; the epoch advances only when all pinned threads
+    // have observed the current one, so a thread which stays pinned for long holds the reclamation of everyone;
+    // guards are cheap (no per pointer fences) and nest
+    class epoch_domain final {
+        struct record;
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(epoch_domain)
+
+        epoch_domain() = default;
+
+        // no thread is supposed to use the domain anymore
+        ~epoch_domain() {
+            m_registry.for_each([](record& r) {
+                for (auto&& retired : r.retired)
+                    retired.ptr.reclaim();
+                r.retired.clear();
+            });
+        }
+
+        // critical section of the calling thread, must not outlive it
+        class guard final {
+        public:
+            HOPE_THREADING_CONSTRUCTABLE_ONLY(guard)
+
+            explicit guard(epoch_domain& domain)
+                : m_record(domain.m_registry.local()) {
+                if (m_record.nesting++ == 0) {
+                    const auto epoch = domain.m_epoch.load(std::memory_order_relaxed);
+                    m_record.epoch.store(pinned(epoch), std::memory_order_relaxed);
+                    // the pin has to be visible before any protected load
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                }
+            }
+
+            ~guard() {
+                if (--m_record.nesting == 0)
+                    m_record.epoch.store(0, std::memory_order_release);
+            }
+
+            // the whole critical section is protected, the load needs no extra publication
+            template<typename T>
+            T* protect(const std::atomic<T*>& src) noexcept {
+                return src.load(std::memory_order_acquire);
+            }
+
+        private:
+            record& m_record;
+        };
+
+        template<typename T>
+        void retire(T* ptr) {
+            retire(ptr, &default_reclaim_deleter<T>);
+        }
+
+        void retire(void* ptr, void(*deleter)(void*)) {
+            auto&& r = m_registry.local();
+            r.retired.push_back({ { ptr, deleter }, m_epoch.load(std::memory_order_acquire) });
+            if (r.retired.size() >= batch_size)
+                collect(r);
+        }
+
+        void reclaim() {
+            collect(m_registry.local());
+        }
+
+        uint64_t epoch() const noexcept {
+            return m_epoch.load(std::memory_order_relaxed);
+        }
+
+    private:
+        constexpr static std::size_t batch_size = 128;
+
+        struct epoch_retired_ptr final {
+            retired_ptr ptr;
+            uint64_t epoch;
+        };
+
+        struct alignas(CACHE_LINE_SIZE) record final {
+            // pinned(global epoch) while the thread is inside of a critical section, zero otherwise
+            std::atomic<uint64_t> epoch{ 0 };
+            std::atomic<bool> owned{ false };
+            record* next{ nullptr };
+
+            // owner only
+            std::size_t nesting{ 0 };
+            std::vector<epoch_retired_ptr> retired;
+        };
+
+        constexpr static uint64_t pinned(uint64_t epoch) noexcept {
+            return (epoch << 1) | 1;
+        }
+
+        // moves the global epoch forward if every pinned thread is in the current one
+        void try_advance() {
+            const auto epoch = m_epoch.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool all_observed = true;
+            m_registry.for_each([&](record& r) {
+                const auto local = r.epoch.load(std::memory_order_acquire);
+                all_observed = all_observed && (local == 0 || local == pinned(epoch));
+            });
+            if (!all_observed)
+                return;
+
+            auto expected = epoch;
+            (void)m_epoch.compare_exchange_strong(expected, epoch + 1, std::memory_order_acq_rel, std::memory_order_relaxed);
+        }
+
+        void collect(record& r) {
+            try_advance();
+            const auto epoch = m_epoch.load(std::memory_order_acquire);
+
+            auto survived = std::partition(r.retired.begin(), r.retired.end(), [epoch](const epoch_retired_ptr& retired) {
+                return retired.epoch + 2 > epoch;
+            });
+            // a deleter might retire something else
+            std::vector<epoch_retired_ptr> reclaimable(survived, r.retired.end());
+            r.retired.erase(survived, r.retired.end());
+            for (auto&& retired : reclaimable)
+                retired.ptr.reclaim();
+        }
+
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_epoch{ 1 };
+        thread_registry<record> m_registry;
+    };
+
+}
@@ -0,0 +1,144 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "hope_thread/core/reclamation.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // Michael's hazard pointers: every thread owns HazardsPerThread slots, a guard occupies one of them;
+    // retired nodes are kept in the list of the retiring thread, once the list is long enough
+    // (a multiple of the total count of slots) it is scanned against all the published hazards at once
+    template<std::size_t HazardsPerThread = 4>
+    class hazard_pointer_domain final {
+        static_assert(HazardsPerThread > 0 && HazardsPerThread <= 32, "busy slots are tracked by a 32 bit mask");
+        struct record;
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(hazard_pointer_domain)
+
+        hazard_pointer_domain() = default;
+
+        // no thread is supposed to use the domain anymore
+        ~hazard_pointer_domain() {
+            m_registry.for_each([](record& r) {
+                for (auto&& retired : r.retired)
+                    retired.reclaim();
+                r.retired.clear();
+            });
+        }
+
+        // owns one hazard slot of the calling thread, must not outlive it
+        class guard final {
+        public:
+            HOPE_THREADING_CONSTRUCTABLE_ONLY(guard)
+
+            explicit guard(hazard_pointer_domain& domain)
+                : m_record(domain.m_registry.local()) {
+                assert(m_record.busy_slots != (1u << HazardsPerThread) - 1 && "all hazard slots of the thread are taken");
+                while ((m_record.busy_slots & (1u << m_slot)) != 0)
+                    ++m_slot;
+                m_record.busy_slots |= 1u << m_slot;
+            }
+
+            ~guard() {
+                reset();
+                m_record.busy_slots &= ~(1u << m_slot);
+            }
+
+            // loads the pointer and publishes it as a hazard until it is stable
+            template<typename T>
+            T* protect(const std::atomic<T*>& src) noexcept {
+                auto* ptr = src.load(std::memory_order_relaxed);
+                for (;;) {
+                    m_record.hazards[m_slot].store(ptr, std::memory_order_seq_cst);
+                    auto* actual = src.load(std::memory_order_acquire);
+                    if (actual == ptr)
+                        return ptr;
+                    ptr = actual;
+                }
+            }
+
+            void reset() noexcept {
+                m_record.hazards[m_slot].store(nullptr, std::memory_order_release);
+            }
+
+        private:
+            record& m_record;
+            std::size_t m_slot{ 0 };
+        };
+
+        template<typename T>
+        void retire(T* ptr) {
+            retire(ptr, &default_reclaim_deleter<T>);
+        }
+
+        void retire(void* ptr, void(*deleter)(void*)) {
+            auto&& r = m_registry.local();
+            r.retired.push_back({ ptr, deleter });
+            if (r.retired.size() >= threshold())
+                scan(r);
+        }
+
+        void reclaim() {
+            scan(m_registry.local());
+        }
+
+    private:
+        constexpr static std::size_t min_batch = 64;
+
+        struct alignas(CACHE_LINE_SIZE) record final {
+            std::atomic<void*> hazards[HazardsPerThread]{ };
+            std::atomic<bool> owned{ false };
+            record* next{ nullptr };
+
+            // owner only
+            uint32_t busy_slots{ 0 };
+            std::vector<retired_ptr> retired;
+            std::vector<void*> hazards_snapshot;
+        };
+
+        std::size_t threshold() const noexcept {
+            return std::max(min_batch, 2 * HazardsPerThread * m_registry.size());
+        }
+
+        void scan(record& r) {
+            // hazards published before the nodes became unreachable are seen after this fence
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            auto&& hazards = r.hazards_snapshot;
+            hazards.clear();
+            m_registry.for_each([&hazards](record& other) {
+                for (auto&& hazard : other.hazards) {
+                    if (auto* ptr = hazard.load(std::memory_order_acquire); ptr != nullptr)
+                        hazards.push_back(ptr);
+                }
+            });
+            std::sort(hazards.begin(), hazards.end());
+
+            auto survived = std::partition(r.retired.begin(), r.retired.end(), [&hazards](const retired_ptr& retired) {
+                return std::binary_search(hazards.begin(), hazards.end(), retired.ptr);
+            });
+            // a deleter might retire something else
+            std::vector<retired_ptr> reclaimable(survived, r.retired.end());
+            r.retired.erase(survived, r.retired.end());
+            for (auto&& retired : reclaimable)
+                retired.reclaim();
+        }
+
+        thread_registry<record> m_registry;
+    };
+
+}
@@ -0,0 +1,174 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "hope_thread/core/reclamation.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    namespace detail {
+
+        // HDR-like log-linear layout: values below 2^sub_bits have a bucket of their own,
+        // every next power of two is split into 2^sub_bits equal buckets, so the relative error is 1 / 2^sub_bits
+        struct log_linear_buckets final {
+            constexpr static std::size_t sub_bits = 4;
+            constexpr static std::size_t sub_count = std::size_t(1) << sub_bits;
+            constexpr static std::size_t count = (64 - sub_bits + 1) * sub_count;
+
+            constexpr static std::size_t index_of(uint64_t value) noexcept {
+                if (value < sub_count)
+                    return (std::size_t)value;
+                const std::size_t msb = 63 - std::countl_zero(value);
+                const std::size_t shift = msb - sub_bits;
+                return (msb - sub_bits + 1) * sub_count + (std::size_t)((value >> shift) & (sub_count - 1));
+            }
+
+            // the greatest value which falls into the bucket
+            constexpr static uint64_t upper_bound_of(std::size_t index) noexcept {
+                if (index < sub_count)
+                    return index;
+                const std::size_t shift = index / sub_count - 1;
+                const uint64_t base = (uint64_t)(sub_count + index % sub_count) << shift;
+                return base + ((uint64_t(1) << shift) - 1);
+            }
+        };
+
+        // buckets of a single writer, everything is a relaxed atomic so the reader never waits for the writer
+        // and the writer never executes a read-modify-write instruction
+        struct alignas(CACHE_LINE_SIZE) histogram_cells final {
+            void add(uint64_t value) noexcept {
+                bump(counts[log_linear_buckets::index_of(value)], 1);
+                bump(sum, value);
+                if (value < min.load(std::memory_order_relaxed))
+                    min.store(value, std::memory_order_relaxed);
+                if (value > max.load(std::memory_order_relaxed))
+                    max.store(value, std::memory_order_relaxed);
+            }
+
+            static void bump(std::atomic<uint64_t>& counter, uint64_t value) noexcept {
+                counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+
+            std::array<std::atomic<uint64_t>, log_linear_buckets::count> counts{ };
+            std::atomic<uint64_t> sum{ 0 };
+            std::atomic<uint64_t> min{ UINT64_MAX };
+            std::atomic<uint64_t> max{ 0 };
+        };
+
+    }
+
+    // plain log-linear histogram of one thread, also the result of a concurrent_histogram snapshot
+    class histogram final {
+    public:
+        void record(uint64_t value) noexcept {
+            ++m_counts[detail::log_linear_buckets::index_of(value)];
+            ++m_total;
+            m_sum += value;
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+        }
+
+        void merge(const histogram& other) noexcept {
+            for (std::size_t i{ 0 }; i < m_counts.size(); ++i)
+                m_counts[i] += other.m_counts[i];
+            m_total += other.m_total;
+            m_sum += other.m_sum;
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+        }
+
+        void merge(const detail::histogram_cells& cells) noexcept {
+            for (std::size_t i{ 0 }; i < m_counts.size(); ++i) {
+                const auto count = cells.counts[i].load(std::memory_order_relaxed);
+                m_counts[i] += count;
+                m_total += count;
+            }
+            m_sum += cells.sum.load(std::memory_order_relaxed);
+            m_min = std::min(m_min, cells.min.load(std::memory_order_relaxed));
+            m_max = std::max(m_max, cells.max.load(std::memory_order_relaxed));
+        }
+
+        // counts recorded since the older snapshot of the same histogram was taken;
+        // min and max are not subtractable, they stay the ones of the whole lifetime
+        void subtract(const histogram& older) noexcept {
+            for (std::size_t i{ 0 }; i < m_counts.size(); ++i)
+                m_counts[i] -= std::min(m_counts[i], older.m_counts[i]);
+            m_total -= std::min(m_total, older.m_total);
+            m_sum -= std::min(m_sum, older.m_sum);
+        }
+
+        // upper bound of the bucket which holds the value of the given rank, p is in [0, 100]
+        uint64_t percentile(double p) const noexcept {
+            if (m_total == 0)
+                return 0;
+            const auto rank = std::max<uint64_t>(1, (uint64_t)(p / 100.0 * (double)m_total + 0.5));
+            uint64_t seen{ 0 };
+            for (std::size_t i{ 0 }; i < m_counts.size(); ++i) {
+                seen += m_counts[i];
+                if (seen >= rank)
+                    return std::min(detail::log_linear_buckets::upper_bound_of(i), m_max);
+            }
+            return m_max;
+        }
+
+        uint64_t count() const noexcept { return m_total; }
+        uint64_t sum() const noexcept { return m_sum; }
+        uint64_t min() const noexcept { return m_total == 0 ? 0 : m_min; }
+        uint64_t max() const noexcept { return m_max; }
+        double mean() const noexcept { return m_total == 0 ? 0.0 : (double)m_sum / (double)m_total; }
+
+    private:
+        std::array<uint64_t, detail::log_linear_buckets::count> m_counts{ };
+        uint64_t m_total{ 0 };
+        uint64_t m_sum{ 0 };
+        uint64_t m_min{ UINT64_MAX };
+        uint64_t m_max{ 0 };
+    };
+
+    // every thread records into buckets of its own (thread_registry record), so recording is a couple of
+    // plain stores into the thread local cache lines; snapshot merges all the records on the reader side
+    // and might be called at any moment, it never blocks the writers
+    class concurrent_histogram final {
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(concurrent_histogram)
+
+        concurrent_histogram() = default;
+        ~concurrent_histogram() = default;
+
+        void record(uint64_t value) {
+            m_registry.local().cells.add(value);
+        }
+
+        histogram snapshot() const noexcept {
+            histogram result;
+            m_registry.for_each([&result](const thread_record& r) {
+                result.merge(r.cells);
+            });
+            return result;
+        }
+
+    private:
+        struct thread_record final {
+            std::atomic<bool> owned{ false };
+            thread_record* next{ nullptr };
+            detail::histogram_cells cells;
+        };
+
+        thread_registry<thread_record> m_registry;
+    };
+
+}
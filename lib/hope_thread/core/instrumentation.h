@@ -0,0 +1,134 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "hope_thread/core/histogram.h"
+#include "hope_thread/core/reclamation.h"
+#include "hope_thread/foundation.h"
+
+// opt-in instrumentation of the bounded queues (mpmc_bounded_queue, mpsc_bounded_queue, spsc_bounded_queue):
+// the queues take the instrumentation policy as the last template parameter, its default is
+// default_queue_instrumentation which is null_queue_instrumentation unless the whole build is compiled with
+// -DHOPE_THREADING_QUEUE_INSTRUMENTATION=1; the null policy is empty and all of its hooks are empty inline
+// functions, so a queue without instrumentation is byte to byte the same as before
+//     mpmc_bounded_queue<job, mpmc_layout::padded, queue_instrumentation> q(1024);
+//     ...
+//     auto&& stats = q.stats();   // from any thread, at any moment
+//     stats.residency.percentile(99);
+
+#ifndef HOPE_THREADING_QUEUE_INSTRUMENTATION
+#define HOPE_THREADING_QUEUE_INSTRUMENTATION 0
+#endif
+
+namespace hope::threading {
+
+    // counters are totals since the queue was created, subtract two scrapes to get the rates
+    struct queue_stats final {
+        uint64_t enqueued{ 0 };
+        uint64_t dequeued{ 0 };
+        uint64_t full_failures{ 0 };  // try_enqueue which found the queue full
+        uint64_t empty_failures{ 0 }; // try_dequeue which found the queue empty
+        uint64_t cas_retries{ 0 };    // extra rounds of the claim loops because of the other threads
+        histogram residency;          // ns between the enqueue and the dequeue of an item
+    };
+
+    class null_queue_instrumentation final {
+    public:
+        struct timestamp_t final { };
+
+        constexpr static bool enabled = false;
+
+        timestamp_t on_enqueue(std::size_t = 1) noexcept { return { }; }
+        void on_dequeue(timestamp_t) noexcept { }
+        void on_full() noexcept { }
+        void on_empty() noexcept { }
+        void on_retries(std::size_t) noexcept { }
+
+        queue_stats stats() const noexcept { return { }; }
+    };
+
+    // every thread which touches the queue gets a record of its own, the hooks are relaxed stores
+    // into that record only; stats() sums the records up without any synchronization with the queue users
+    class queue_instrumentation final {
+    public:
+        using timestamp_t = uint64_t;
+
+        constexpr static bool enabled = true;
+
+        static timestamp_t now() noexcept {
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // count: items published at once with the returned stamp
+        timestamp_t on_enqueue(std::size_t count = 1) {
+            auto&& r = m_registry.local();
+            detail::histogram_cells::bump(r.enqueued, count);
+            return now();
+        }
+
+        void on_dequeue(timestamp_t enqueued_at) {
+            const auto stamp = now();
+            auto&& r = m_registry.local();
+            detail::histogram_cells::bump(r.dequeued, 1);
+            r.residency.add(stamp > enqueued_at ? stamp - enqueued_at : 0);
+        }
+
+        void on_full() {
+            detail::histogram_cells::bump(m_registry.local().full_failures, 1);
+        }
+
+        void on_empty() {
+            detail::histogram_cells::bump(m_registry.local().empty_failures, 1);
+        }
+
+        void on_retries(std::size_t count) {
+            if (count != 0)
+                detail::histogram_cells::bump(m_registry.local().cas_retries, count);
+        }
+
+        queue_stats stats() const noexcept {
+            queue_stats result;
+            m_registry.for_each([&result](const record& r) {
+                result.enqueued += r.enqueued.load(std::memory_order_relaxed);
+                result.dequeued += r.dequeued.load(std::memory_order_relaxed);
+                result.full_failures += r.full_failures.load(std::memory_order_relaxed);
+                result.empty_failures += r.empty_failures.load(std::memory_order_relaxed);
+                result.cas_retries += r.cas_retries.load(std::memory_order_relaxed);
+                result.residency.merge(r.residency);
+            });
+            return result;
+        }
+
+    private:
+        struct record final {
+            std::atomic<bool> owned{ false };
+            record* next{ nullptr };
+
+            alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> enqueued{ 0 };
+            std::atomic<uint64_t> dequeued{ 0 };
+            std::atomic<uint64_t> full_failures{ 0 };
+            std::atomic<uint64_t> empty_failures{ 0 };
+            std::atomic<uint64_t> cas_retries{ 0 };
+            detail::histogram_cells residency;
+        };
+
+        thread_registry<record> m_registry;
+    };
+
+    using default_queue_instrumentation = std::conditional_t<HOPE_THREADING_QUEUE_INSTRUMENTATION != 0,
+        queue_instrumentation, null_queue_instrumentation>;
+
+}
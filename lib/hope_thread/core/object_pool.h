@@ -0,0 +1,209 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "hope_thread/containers/stack/freelist.h"
+#include "hope_thread/core/reclamation.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // pool of fixed size blocks (Bonwick's magazines): every thread caches blocks in two magazines of its own,
+    // full and empty magazines are exchanged with the lock-free depot, so a thread touches shared state
+    // once per magazine_capacity operations at most; when the depot runs dry a whole chunk of blocks
+    // is allocated at once, chunks are released together with the pool, there is no cap on their count
+    class block_pool final {
+        struct record;
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(block_pool)
+
+        constexpr static std::size_t magazine_capacity = 64;
+
+        // blocks_per_chunk is rounded up to a whole count of magazines
+        block_pool(std::size_t block_size, std::size_t alignment = alignof(std::max_align_t),
+            std::size_t blocks_per_chunk = magazine_capacity)
+            : m_alignment(std::max(alignment, alignof(void*)))
+            , m_block_size(align_up(std::max(block_size, sizeof(void*)), m_alignment))
+            , m_chunk_header_size(align_up(sizeof(chunk), m_alignment))
+            , m_blocks_per_chunk(align_up(std::max(blocks_per_chunk, magazine_capacity), magazine_capacity)) {
+            assert((alignment & (alignment - 1)) == 0);
+        }
+
+        // every block must be returned (or abandoned) by now, no thread is supposed to use the pool anymore
+        ~block_pool() {
+            m_registry.for_each([](record& r) {
+                delete r.loaded;
+                delete r.previous;
+            });
+            while (auto* m = m_full.try_pop())
+                delete m;
+            while (auto* m = m_empty.try_pop())
+                delete m;
+            while (auto* c = m_chunks.try_pop())
+                ::operator delete(c, std::align_val_t{ m_alignment });
+        }
+
+        void* allocate() {
+            auto&& r = local();
+            if (r.loaded->count == 0) {
+                if (r.previous->count != 0) {
+                    std::swap(r.loaded, r.previous);
+                } else if (auto* full = m_full.try_pop()) {
+                    m_empty.push(r.previous);
+                    r.previous = r.loaded;
+                    r.loaded = full;
+                } else {
+                    fill_from_new_chunk(*r.loaded);
+                }
+            }
+            return r.loaded->blocks[--r.loaded->count];
+        }
+
+        void deallocate(void* block) {
+            auto&& r = local();
+            if (r.loaded->count == magazine_capacity) {
+                if (r.previous->count == 0) {
+                    std::swap(r.loaded, r.previous);
+                } else {
+                    m_full.push(r.previous);
+                    r.previous = r.loaded;
+                    r.loaded = take_empty_magazine();
+                }
+            }
+            r.loaded->blocks[r.loaded->count++] = block;
+        }
+
+        std::size_t block_size() const noexcept {
+            return m_block_size;
+        }
+
+        std::size_t blocks_per_chunk() const noexcept {
+            return m_blocks_per_chunk;
+        }
+
+        // count of chunks allocated so far
+        std::size_t chunks_count() const noexcept {
+            return m_chunks_count.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct magazine final : freelist_hook {
+            std::size_t count{ 0 };
+            void* blocks[magazine_capacity];
+        };
+
+        struct chunk final : freelist_hook { };
+
+        struct alignas(CACHE_LINE_SIZE) record final {
+            std::atomic<bool> owned{ false };
+            record* next{ nullptr };
+
+            // owner only, the magazines stay with the record when the thread exits
+            magazine* loaded{ nullptr };
+            magazine* previous{ nullptr };
+        };
+
+        static std::size_t align_up(std::size_t size, std::size_t alignment) noexcept {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        record& local() {
+            auto&& r = m_registry.local();
+            if (r.loaded == nullptr) {
+                r.loaded = take_empty_magazine();
+                r.previous = take_empty_magazine();
+            }
+            return r;
+        }
+
+        magazine* take_empty_magazine() {
+            if (auto* m = m_empty.try_pop())
+                return m;
+            return new magazine;
+        }
+
+        // the first magazine of the chunk goes to the caller, the rest of them are published as full ones
+        void fill_from_new_chunk(magazine& m) {
+            auto* memory = static_cast<unsigned char*>(::operator new(m_chunk_header_size + m_block_size * m_blocks_per_chunk,
+                                                                     std::align_val_t{ m_alignment }));
+            m_chunks.push(new (memory) chunk);
+            m_chunks_count.fetch_add(1, std::memory_order_relaxed);
+
+            auto* blocks = memory + m_chunk_header_size;
+            fill_magazine(m, blocks);
+            for (std::size_t offset{ magazine_capacity }; offset < m_blocks_per_chunk; offset += magazine_capacity) {
+                auto* extra = take_empty_magazine();
+                fill_magazine(*extra, blocks + offset * m_block_size);
+                m_full.push(extra);
+            }
+        }
+
+        void fill_magazine(magazine& m, unsigned char* blocks) const noexcept {
+            for (std::size_t i{ 0 }; i < magazine_capacity; ++i)
+                m.blocks[i] = blocks + i * m_block_size;
+            m.count = magazine_capacity;
+        }
+
+        const std::size_t m_alignment;
+        const std::size_t m_block_size;
+        const std::size_t m_chunk_header_size;
+        const std::size_t m_blocks_per_chunk;
+
+        freelist<magazine> m_full;
+        freelist<magazine> m_empty;
+        freelist<chunk> m_chunks;
+        std::atomic<std::size_t> m_chunks_count{ 0 };
+        thread_registry<record> m_registry;
+    };
+
+    // typed facade over the block_pool
+    template<typename T>
+    class object_pool final {
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(object_pool)
+
+        object_pool()
+            : m_blocks(sizeof(T), alignof(T)) { }
+
+        ~object_pool() = default;
+
+        template<typename... Args>
+        T* create(Args&&... args) {
+            void* block = m_blocks.allocate();
+            try {
+                return new (block) T(std::forward<Args>(args)...);
+            } catch (...) {
+                m_blocks.deallocate(block);
+                throw;
+            }
+        }
+
+        // might be called from any thread, not necessarily the one which created the object
+        void destroy(T* object) {
+            object->~T();
+            m_blocks.deallocate(object);
+        }
+
+        std::size_t chunks_count() const noexcept {
+            return m_blocks.chunks_count();
+        }
+
+    private:
+        block_pool m_blocks;
+    };
+
+}
@@ -0,0 +1,176 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "hope_thread/foundation.h"
+
+// common part of the reclamation domains (hazard_pointer.h, epoch.h), both of them expose the same api:
+//     domain_t::guard g(domain);          // per thread critical section / hazard slot
+//     auto* p = g.protect(shared_ptr);    // p stays valid while the guard is alive
+//     domain.retire(p);                   // deleted once no guard can observe it
+//     domain.reclaim();                   // tries to free the retired nodes of the calling thread right now
+
+namespace hope::threading {
+
+    // type erased node waiting for the reclamation
+    struct retired_ptr final {
+        void* ptr;
+        void(*deleter)(void*);
+
+        void reclaim() const {
+            deleter(ptr);
+        }
+    };
+
+    template<typename T>
+    void default_reclaim_deleter(void* ptr) {
+        delete static_cast<T*>(ptr);
+    }
+
+    namespace detail {
+
+        // ids of the alive registries, a thread which exits releases its records only in the alive ones
+        struct registry_table final {
+            std::mutex lock;
+            std::unordered_set<uint64_t> alive;
+            uint64_t next_id{ 1 };
+        };
+
+        inline registry_table& get_registry_table() {
+            static registry_table table;
+            return table;
+        }
+
+        struct thread_record_entry final {
+            uint64_t registry_id;
+            void* record;
+            void(*release)(void*);
+        };
+
+        // records owned by the calling thread in all the registries
+        struct thread_records final {
+            ~thread_records() {
+                auto&& table = get_registry_table();
+                std::lock_guard lk(table.lock);
+                for (auto&& entry : entries) {
+                    if (table.alive.count(entry.registry_id) != 0)
+                        entry.release(entry.record);
+                }
+            }
+
+            std::vector<thread_record_entry> entries;
+        };
+
+        inline thread_records& get_thread_records() {
+            thread_local thread_records records;
+            return records;
+        }
+
+    }
+
+    // lock-free list of per thread records, a record is bound to a thread on the first use
+    // and handed over to the next thread once the owner exits (with everything the owner did not reclaim);
+    // records are released together with the registry
+    template<typename TRecord>
+    class thread_registry final {
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(thread_registry)
+
+        thread_registry() {
+            auto&& table = detail::get_registry_table();
+            std::lock_guard lk(table.lock);
+            m_id = table.next_id++;
+            table.alive.insert(m_id);
+        }
+
+        ~thread_registry() {
+            {
+                auto&& table = detail::get_registry_table();
+                std::lock_guard lk(table.lock);
+                table.alive.erase(m_id);
+            }
+            auto* record = m_head.load(std::memory_order_acquire);
+            while (record != nullptr) {
+                auto* next = record->next;
+                delete record;
+                record = next;
+            }
+        }
+
+        TRecord& local() {
+            thread_local const thread_registry* cached_registry{ nullptr };
+            thread_local uint64_t cached_id{ 0 };
+            thread_local TRecord* cached_record{ nullptr };
+            if (cached_registry == this && cached_id == m_id)
+                return *cached_record;
+
+            auto&& entries = detail::get_thread_records().entries;
+            TRecord* record = nullptr;
+            for (auto&& entry : entries) {
+                if (entry.registry_id == m_id) {
+                    record = static_cast<TRecord*>(entry.record);
+                    break;
+                }
+            }
+            if (record == nullptr) {
+                record = acquire();
+                entries.push_back({ m_id, record, &release });
+            }
+
+            cached_registry = this;
+            cached_id = m_id;
+            cached_record = record;
+            return *record;
+        }
+
+        template<typename F>
+        void for_each(F&& f) const {
+            for (auto* record = m_head.load(std::memory_order_acquire); record != nullptr; record = record->next)
+                f(*record);
+        }
+
+        std::size_t size() const noexcept {
+            return m_size.load(std::memory_order_relaxed);
+        }
+
+    private:
+        TRecord* acquire() {
+            for (auto* record = m_head.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+                bool expected = false;
+                if (!record->owned.load(std::memory_order_relaxed)
+                    && record->owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return record;
+            }
+
+            auto* record = new TRecord;
+            record->owned.store(true, std::memory_order_relaxed);
+            auto* head = m_head.load(std::memory_order_relaxed);
+            do {
+                record->next = head;
+            } while (!m_head.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            return record;
+        }
+
+        static void release(void* record) {
+            static_cast<TRecord*>(record)->owned.store(false, std::memory_order_release);
+        }
+
+        std::atomic<TRecord*> m_head{ nullptr };
+        std::atomic<std::size_t> m_size{ 0 };
+        uint64_t m_id{ 0 };
+    };
+
+}
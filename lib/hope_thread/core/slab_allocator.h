@@ -0,0 +1,74 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "hope_thread/core/object_pool.h"
+
+namespace hope::threading {
+
+    // size of the memory a slab carves its nodes from at once
+    inline constexpr std::size_t slab_size{ 64 * 1024 };
+
+    namespace detail {
+
+        // one pool per node size and alignment, shared by every container of the process;
+        // the pool is never destroyed, so containers with static storage duration may outlive everything else
+        template<std::size_t Size, std::size_t Alignment>
+        block_pool& get_slab_pool() {
+            static auto* pool = new block_pool(Size, Alignment, std::max<std::size_t>(slab_size / Size, 1));
+            return *pool;
+        }
+
+    }
+
+    // stateless node allocator for the node based containers (queues, hash_storage collision lists):
+    // single objects are taken from the per thread magazines of the slab pool of their size,
+    // so the steady state does not call malloc at all, and the nodes allocated one after another lie side by side;
+    // arrays fall back to ::operator new, memory of the slabs is kept by the process until it exits
+    template<typename T>
+    class slab_allocator {
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        template<typename U>
+        struct rebind final {
+            using other = slab_allocator<U>;
+        };
+
+        slab_allocator() noexcept = default;
+
+        template<typename U>
+        slab_allocator(const slab_allocator<U>&) noexcept { }
+
+        T* allocate(std::size_t n) {
+            if (n == 1)
+                return static_cast<T*>(detail::get_slab_pool<sizeof(T), alignof(T)>().allocate());
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignof(T) }));
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept {
+            if (n == 1)
+                detail::get_slab_pool<sizeof(T), alignof(T)>().deallocate(ptr);
+            else
+                ::operator delete(ptr, std::align_val_t{ alignof(T) });
+        }
+
+        template<typename U>
+        bool operator==(const slab_allocator<U>&) const noexcept {
+            return true;
+        }
+    };
+
+}
@@ -1,4 +1,4 @@
-/* Copyright (C) 2024 - 2026 Gleb Bezborodov - All Rights Reserved
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
  * You may use, distribute and modify this code under the
  * terms of the MIT license.
  *
@@ -8,38 +8,193 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <new>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#   include <intrin.h>
+#endif
+
+// double width cas is used if the compiler can inline it (gcc/clang with -mcx16, msvc x64),
+// otherwise the tag is packed into the unused upper bits of the pointer
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) || (defined(_MSC_VER) && defined(_M_X64))
+#   define HOPE_THREADING_HAS_DWCAS 1
+#else
+#   define HOPE_THREADING_HAS_DWCAS 0
+#endif
+
 namespace hope::threading {
 
-    template<typename TPtr = void*>
+#if HOPE_THREADING_HAS_DWCAS
+
+    // pointer and a full word tag side by side, swapped together with cmpxchg16b
+    template<typename T>
+    struct alignas(16) tagged_ptr final {
+        constexpr static std::size_t tag_bits_count{ 64 };
+
+        tagged_ptr() noexcept = default;
+        tagged_ptr(T* in_ptr, uint64_t in_tag) noexcept
+            : ptr(in_ptr), tag(in_tag) { }
+
+        T* get_ptr() const noexcept {
+            return ptr;
+        }
+
+        uint64_t get_tag() const noexcept {
+            return tag;
+        }
+
+        void set_ptr(T* in_ptr) noexcept {
+            ptr = in_ptr;
+        }
+
+        void set_tag(uint64_t in_tag) noexcept {
+            tag = in_tag;
+        }
+
+        void set_all(T* in_ptr, uint64_t in_tag) noexcept {
+            ptr = in_ptr;
+            tag = in_tag;
+        }
+
+        bool operator==(const tagged_ptr& other) const noexcept = default;
+
+        T* ptr{ nullptr };
+        uint64_t tag{ 0 };
+    };
+
+#else
+
+    // x64 ptr has 48 significant bits for address resolving, the upper 16 bits hold the tag
+    template<typename T>
     struct alignas(8) tagged_ptr final {
-        // x64 ptr has 48 significant bits for address relosving, and the rest of the bits we can use here
+        static_assert(sizeof(void*) == 8, "packed tagged pointer needs 64 bit pointers");
+
+        constexpr static std::size_t tag_bits_count{ 16 };
+        constexpr static std::size_t ptr_bits_count{ 64 - tag_bits_count };
+        constexpr static uint64_t ptr_mask{ (uint64_t(1) << ptr_bits_count) - 1 };
+
+        tagged_ptr() noexcept = default;
+        tagged_ptr(T* in_ptr, uint64_t in_tag) noexcept {
+            set_all(in_ptr, in_tag);
+        }
 
-        static constexpr std::size_t TagBitsCount{ 26 };
-        static constexpr std::size_t TagMask{ (1 << TagBitsCount) - 1 };
+        T* get_ptr() const noexcept {
+            // sign extension keeps the pointer canonical
+            return reinterpret_cast<T*>((int64_t)(bits << tag_bits_count) >> tag_bits_count);
+        }
+
+        uint64_t get_tag() const noexcept {
+            return bits >> ptr_bits_count;
+        }
+
+        void set_ptr(T* in_ptr) noexcept {
+            set_all(in_ptr, get_tag());
+        }
+
+        void set_tag(uint64_t in_tag) noexcept {
+            set_all(get_ptr(), in_tag);
+        }
+
+        void set_all(T* in_ptr, uint64_t in_tag) noexcept {
+            bits = (in_tag << ptr_bits_count) | (reinterpret_cast<uint64_t>(in_ptr) & ptr_mask);
+        }
+
+        bool operator==(const tagged_ptr& other) const noexcept = default;
+
+        uint64_t bits{ 0 };
+    };
+
+#endif
+
+    // atomic cell for the tagged_ptr, the tag is supposed to be bumped by every successful exchange
+    template<typename T>
+    class atomic_tagged_ptr final {
+    public:
+        using value_type = tagged_ptr<T>;
 
-        TPtr get_ptr() const noexcept {
-            return (Ptr >> TagBitsCount);
+        atomic_tagged_ptr() noexcept = default;
+        explicit atomic_tagged_ptr(value_type value) noexcept : m_value(value) { }
+
+        atomic_tagged_ptr(const atomic_tagged_ptr&) = delete;
+        atomic_tagged_ptr& operator=(const atomic_tagged_ptr&) = delete;
+
+#if HOPE_THREADING_HAS_DWCAS
+        // the halves are loaded separately, a torn value never passes the following compare_exchange
+        value_type load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            value_type result;
+            result.tag = std::atomic_ref<uint64_t>(m_value.tag).load(order);
+            result.ptr = std::atomic_ref<T*>(m_value.ptr).load(order);
+            return result;
         }
 
-        std::size_t get_tag() const noexcept {
-            return Ptr & TagMask;
+        // the order is accepted for the api compatibility only: both __sync_val_compare_and_swap and
+        // _InterlockedCompareExchange128 are full barriers whether the exchange succeeds or not, so a failed
+        // exchange acquires the value it writes back to expected (a plain load() with a weaker order does not)
+        void store(value_type value, std::memory_order = std::memory_order_seq_cst) noexcept {
+            auto expected = load(std::memory_order_relaxed);
+            while (!compare_exchange_weak(expected, value)) { }
         }
 
-        void set_ptr(TPtr in_ptr) noexcept {
-            ptr = get_tag() | (in_ptr << TagBitsCount);
+        bool compare_exchange_weak(value_type& expected, value_type desired,
+            std::memory_order = std::memory_order_seq_cst) noexcept {
+#if defined(_MSC_VER)
+            return _InterlockedCompareExchange128(reinterpret_cast<volatile long long*>(&m_value),
+                (long long)desired.tag, (long long)desired.ptr, reinterpret_cast<long long*>(&expected)) != 0;
+#else
+            using wide_t = unsigned __int128;
+            wide_t expected_wide;
+            wide_t desired_wide;
+            static_assert(sizeof(wide_t) == sizeof(value_type));
+            __builtin_memcpy(&expected_wide, &expected, sizeof(wide_t));
+            __builtin_memcpy(&desired_wide, &desired, sizeof(wide_t));
+            const auto previous = __sync_val_compare_and_swap(reinterpret_cast<wide_t*>(&m_value), expected_wide, desired_wide);
+            if (previous == expected_wide)
+                return true;
+            __builtin_memcpy(static_cast<void*>(&expected), &previous, sizeof(wide_t));
+            return false;
+#endif
+        }
+#else
+        value_type load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            value_type result;
+            result.bits = std::atomic_ref<uint64_t>(m_value.bits).load(order);
+            return result;
         }
 
-        void set_tag(std::size_t tag) noexcept {
-            ptr = tag | (get_ptr() << TagBitsCount);
+        void store(value_type value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            std::atomic_ref<uint64_t>(m_value.bits).store(value.bits, order);
         }
 
-        void set_all(TPtr in_ptr, std::size_t tag) {
-            ptr = (uint64_t(tag) | (in_ptr << TagBitsCount));
+        bool compare_exchange_weak(value_type& expected, value_type desired,
+            std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return std::atomic_ref<uint64_t>(m_value.bits).compare_exchange_weak(expected.bits, desired.bits,
+                order, failure_order(order));
         }
+#endif
 
-        uint64_t ptr{ 0u };
+        bool compare_exchange_strong(value_type& expected, value_type desired,
+            std::memory_order order = std::memory_order_seq_cst) noexcept {
+            const auto wanted = expected;
+            while (!compare_exchange_weak(expected, desired, order)) {
+                if (!(expected == wanted))
+                    return false;
+            }
+            return true;
+        }
+
+    private:
+        // the refreshed expected value is acquired whenever the exchange would have acquired, as std::atomic does
+        constexpr static std::memory_order failure_order(std::memory_order order) noexcept {
+            if (order == std::memory_order_acq_rel)
+                return std::memory_order_acquire;
+            if (order == std::memory_order_release)
+                return std::memory_order_relaxed;
+            return order;
+        }
+
+        mutable value_type m_value{ };
     };
-}
\ No newline at end of file
+
+}
@@ -0,0 +1,83 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+namespace hope::threading::platform {
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free,
+        "the futex word is addressed as a plain 32 bit integer");
+
+    /**
+     * True if futex_wait really sleeps in the kernel, otherwise it only gives the time slice away.
+     */
+    inline constexpr bool has_shared_futex =
+#if defined(__linux__)
+        true;
+#else
+        false;
+#endif
+
+    /**
+     * Sleeps while \p word holds \p expected. The word might live in a shared memory segment,
+     * the wait is not FUTEX_PRIVATE, so it is woken up by futex_wake from any process mapping the segment.
+     * Returns on wake up, on a spurious wake up or at once if the word does not hold \p expected anymore,
+     * the caller is expected to check its condition again.
+     */
+    inline void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept {
+#if defined(__linux__)
+        (void)::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+#else
+        // no shared futex, the waiter degrades to the yield loop
+        if (word.load(std::memory_order_acquire) == expected)
+            std::this_thread::yield();
+#endif
+    }
+
+    /**
+     * The same as futex_wait, but sleeps at most \p timeout.
+     */
+    inline void futex_wait_for(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout) noexcept {
+#if defined(__linux__)
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        timespec relative{};
+        relative.tv_sec = static_cast<time_t>(seconds.count());
+        relative.tv_nsec = static_cast<long>((timeout - seconds).count());
+        (void)::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &relative, nullptr, 0);
+#else
+        (void)timeout;
+        futex_wait(word, expected);
+#endif
+    }
+
+    /**
+     * Wakes up every process and thread sleeping in futex_wait on \p word.
+     */
+    inline void futex_wake_all(std::atomic<uint32_t>& word) noexcept {
+#if defined(__linux__)
+        (void)::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+        (void)word;
+#endif
+    }
+
+} // namespace hope::threading::platform
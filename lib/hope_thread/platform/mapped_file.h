@@ -0,0 +1,171 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hope::threading::platform {
+
+    /**
+     * A regular file mapped with MAP_SHARED: the writer and the readers of the file share its pages
+     * through the page cache, so whatever one process stores is seen by the others without a read or write call.
+     * Call close_mapped_file when done.
+     */
+    struct mapped_file {
+        void* data{ nullptr };
+        std::size_t size{ 0 };
+        int fd{ -1 };
+        /** True if this call created the file (it was missing or empty). */
+        bool created_new{ false };
+    };
+
+#if defined(_WIN32)
+
+    // not implemented on Windows yet, every call fails
+    inline bool create_or_open_mapped_file(const char*, std::size_t, mapped_file*) noexcept {
+        return false;
+    }
+
+    inline bool open_mapped_file(const char*, bool, mapped_file*) noexcept {
+        return false;
+    }
+
+    inline bool sync_mapped_file(const mapped_file&, std::size_t, std::size_t, bool) noexcept {
+        return false;
+    }
+
+    inline void close_mapped_file(mapped_file&) noexcept { }
+
+#else
+
+    /**
+     * Opens \p path for reading and writing (creating it if it is missing), sizes a new file to \p size_bytes
+     * and maps the first \p size_bytes bytes. The blocks of a new file are allocated at once where the file system
+     * supports it, so the first write to a page does not allocate on disk.
+     * \return false if the existing file is smaller than \p size_bytes or on any system error.
+     */
+    inline bool create_or_open_mapped_file(const char* path, std::size_t size_bytes, mapped_file* out) noexcept {
+        if (!out || !path || size_bytes == 0) {
+            return false;
+        }
+
+        const int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        const bool created_new = st.st_size == 0;
+        if (created_new) {
+#if defined(__linux__)
+            const bool sized = ::posix_fallocate(fd, 0, static_cast<off_t>(size_bytes)) == 0
+                || ::ftruncate(fd, static_cast<off_t>(size_bytes)) == 0;
+#else
+            const bool sized = ::ftruncate(fd, static_cast<off_t>(size_bytes)) == 0;
+#endif
+            if (!sized) {
+                ::close(fd);
+                return false;
+            }
+        } else if (static_cast<std::size_t>(st.st_size) < size_bytes) {
+            ::close(fd);
+            errno = EINVAL;
+            return false;
+        }
+
+        void* p = ::mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+
+        out->data = p;
+        out->size = size_bytes;
+        out->fd = fd;
+        out->created_new = created_new;
+        return true;
+    }
+
+    /**
+     * Maps the whole existing file \p path, read only unless \p writable.
+     */
+    inline bool open_mapped_file(const char* path, bool writable, mapped_file* out) noexcept {
+        if (!out || !path) {
+            return false;
+        }
+
+        const int fd = ::open(path, writable ? O_RDWR : O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        const auto size = static_cast<std::size_t>(st.st_size);
+        void* p = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+
+        out->data = p;
+        out->size = size;
+        out->fd = fd;
+        out->created_new = false;
+        return true;
+    }
+
+    /**
+     * Writes the dirty pages of [offset, offset + length) back to the file.
+     * \param async MS_ASYNC: only schedules the write back, returns at once.
+     */
+    inline bool sync_mapped_file(const mapped_file& file, std::size_t offset, std::size_t length, bool async) noexcept {
+        if (!file.data || length == 0) {
+            return true;
+        }
+        // msync wants a page aligned address
+        const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t begin = offset / page * page;
+        const std::size_t end = offset + length < file.size ? offset + length : file.size;
+        return ::msync(static_cast<char*>(file.data) + begin, end - begin, async ? MS_ASYNC : MS_SYNC) == 0;
+    }
+
+    inline void close_mapped_file(mapped_file& file) noexcept {
+        if (file.data && file.size > 0) {
+            ::munmap(file.data, file.size);
+        }
+        if (file.fd >= 0) {
+            ::close(file.fd);
+        }
+        file.data = nullptr;
+        file.size = 0;
+        file.fd = -1;
+        file.created_new = false;
+    }
+
+#endif
+
+} // namespace hope::threading::platform
@@ -0,0 +1,227 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "hope_thread/platform/futex.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading::platform {
+
+    namespace detail {
+        constexpr uint64_t k_fnv_offset = 14695981039346656037ull;
+        constexpr uint64_t k_fnv_prime = 1099511628211ull;
+
+        constexpr uint64_t fnv1a(const char* str, uint64_t hash = k_fnv_offset) noexcept {
+            for (; *str != '\0'; ++str)
+                hash = (hash ^ static_cast<unsigned char>(*str)) * k_fnv_prime;
+            return hash;
+        }
+
+        constexpr uint64_t fnv1a(uint64_t value, uint64_t hash) noexcept {
+            for (int i = 0; i < 8; ++i, value >>= 8)
+                hash = (hash ^ (value & 0xff)) * k_fnv_prime;
+            return hash;
+        }
+
+        // the signature contains the full name of T with all of its template arguments (capacity included)
+        template<typename T>
+        constexpr const char* type_signature() noexcept {
+#if defined(_MSC_VER)
+            return __FUNCSIG__;
+#else
+            return __PRETTY_FUNCTION__;
+#endif
+        }
+    } // namespace detail
+
+    /**
+     * Hash of the name, size and alignment of \p T. The name is taken from the compiler,
+     * so the processes sharing a segment have to be built by the same compiler.
+     */
+    template<typename T>
+    constexpr uint64_t layout_hash() noexcept {
+        return detail::fnv1a(alignof(T), detail::fnv1a(sizeof(T), detail::fnv1a(detail::type_signature<T>())));
+    }
+
+    enum class segment_state : uint32_t {
+        empty = 0,          // zero filled segment, nobody initialized it yet
+        initializing = 1,   // the producer (re)constructs the object
+        ready = 2
+    };
+
+    /**
+     * Placed at the beginning of a shared memory segment, describes the object which follows it.
+     * state is a futex word: the attaching processes sleep on it until the producer publishes the object.
+     */
+    struct alignas(CACHE_LINE_SIZE) segment_header final {
+        constexpr static uint64_t k_magic = 0x31314d5348504f48ull; // "HOPHSM11"
+        constexpr static uint32_t k_version = 1;
+
+        uint64_t magic;
+        uint32_t version;
+        uint32_t payload_offset;
+        uint64_t payload_size;
+        uint64_t layout_hash;
+        std::atomic<uint32_t> state;
+        /** Incremented every time a producer (re)initializes the segment. */
+        std::atomic<uint32_t> epoch;
+    };
+
+    enum class attach_result : uint8_t {
+        ok,
+        timeout,            // the producer did not publish the object in time
+        bad_magic,          // the segment was not created by create()
+        version_mismatch,   // the segment was created by another version of this header
+        layout_mismatch,    // the object is of another type, size or capacity
+        too_small           // the mapping does not cover the whole object
+    };
+
+    /**
+     * Typed view over a mapped segment holding a segment_header followed by an object of type \p T.
+     * The producer creates the object (a restarted producer creates it again under a new epoch),
+     * the other processes attach: the header is validated and the attach waits (on a futex, not a sleep)
+     * until the object is ready. A consumer which caches positions in the object (a queue reader) checks stale()
+     * when it runs out of data and attaches again once the producer restarted.
+     *     // producer
+     *     shared_segment_object<queue_t> object(segment.data);
+     *     auto* queue = object.create();
+     *     // consumer
+     *     shared_segment_object<queue_t> object(segment.data);
+     *     if (object.attach(std::chrono::seconds(1), segment.size) == attach_result::ok) {
+     *         auto reader = object.get()->create_consumer();
+     *         ...
+     *         if (!reader.try_dequeue(v) && object.stale()) { re-attach and create the reader again }
+     *     }
+     */
+    template<typename T>
+    class shared_segment_object final {
+    public:
+        constexpr static std::size_t payload_offset =
+            (sizeof(segment_header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+        /** Bytes the segment has to have to hold the header and a payload of \p payload_size bytes. */
+        constexpr static std::size_t required_size(std::size_t payload_size = sizeof(T)) noexcept {
+            return payload_offset + payload_size;
+        }
+
+        /** \param memory Beginning of the mapped segment (page aligned). */
+        explicit shared_segment_object(void* memory) noexcept
+            : m_header(static_cast<segment_header*>(memory)) { }
+
+        /**
+         * Producer: constructs T(args...) right after the header and publishes it under a new epoch.
+         */
+        template<typename... Args>
+        T* create(Args&&... args) {
+            return create_with(sizeof(T), [&](void* payload) {
+                return new (payload) T(std::forward<Args>(args)...);
+            });
+        }
+
+        /**
+         * Producer: the payload of a runtime size, \p init(void*) constructs the object and returns it,
+         * e.g. shm_mpmc_bounded_queue<job>::create(payload, capacity).
+         */
+        template<typename F>
+        T* create_with(std::size_t payload_size, F&& init) {
+            // the attached consumers see a not ready state or another epoch from now on
+            m_header->state.store(static_cast<uint32_t>(segment_state::initializing), std::memory_order_relaxed);
+            m_epoch = m_header->epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+            std::atomic_thread_fence(std::memory_order_release);
+
+            m_header->magic = segment_header::k_magic;
+            m_header->version = segment_header::k_version;
+            m_header->payload_offset = static_cast<uint32_t>(payload_offset);
+            m_header->payload_size = payload_size;
+            m_header->layout_hash = layout_hash<T>();
+            m_object = std::forward<F>(init)(payload());
+
+            m_header->state.store(static_cast<uint32_t>(segment_state::ready), std::memory_order_release);
+            futex_wake_all(m_header->state);
+            return m_object;
+        }
+
+        /**
+         * Waits at most \p timeout until the object is ready and validates the header.
+         * \param segment_size Size of the mapping, the object has to fit in it.
+         */
+        attach_result attach(std::chrono::nanoseconds timeout, std::size_t segment_size) noexcept {
+            m_object = nullptr;
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            for (;;) {
+                const auto state = m_header->state.load(std::memory_order_acquire);
+                if (state == static_cast<uint32_t>(segment_state::ready)) {
+                    m_epoch = m_header->epoch.load(std::memory_order_acquire);
+                    const auto result = validate(segment_size);
+                    if (result != attach_result::ok)
+                        return result;
+                    m_object = std::launder(static_cast<T*>(payload()));
+                    // the producer might have restarted while the header was read
+                    if (!stale())
+                        return attach_result::ok;
+                    m_object = nullptr;
+                    continue;
+                }
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= deadline)
+                    return attach_result::timeout;
+                futex_wait_for(m_header->state, state, deadline - now);
+            }
+        }
+
+        /** The object, nullptr until create() or a successful attach(). */
+        T* get() const noexcept {
+            return m_object;
+        }
+
+        /** The epoch the object was created or attached under. */
+        uint32_t epoch() const noexcept {
+            return m_epoch;
+        }
+
+        /** True if the producer is reinitializing the segment or has done it since create() or attach(). */
+        bool stale() const noexcept {
+            return m_header->state.load(std::memory_order_acquire) != static_cast<uint32_t>(segment_state::ready)
+                || m_header->epoch.load(std::memory_order_acquire) != m_epoch;
+        }
+
+        const segment_header& header() const noexcept {
+            return *m_header;
+        }
+
+    private:
+        void* payload() const noexcept {
+            return reinterpret_cast<unsigned char*>(m_header) + payload_offset;
+        }
+
+        attach_result validate(std::size_t segment_size) const noexcept {
+            if (m_header->magic != segment_header::k_magic)
+                return attach_result::bad_magic;
+            if (m_header->version != segment_header::k_version)
+                return attach_result::version_mismatch;
+            if (m_header->layout_hash != layout_hash<T>() || m_header->payload_offset != payload_offset)
+                return attach_result::layout_mismatch;
+            if (m_header->payload_offset + m_header->payload_size > segment_size)
+                return attach_result::too_small;
+            return attach_result::ok;
+        }
+
+        segment_header* m_header;
+        T* m_object{ nullptr };
+        uint32_t m_epoch{ 0 };
+    };
+
+} // namespace hope::threading::platform
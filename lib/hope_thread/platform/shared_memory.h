@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 #if defined(_WIN32)
 #ifndef NOMINMAX
@@ -19,16 +20,50 @@
 #endif
 #include <windows.h>
 #else
+#include <climits>
+#include <cstdio>
 #include <cstring>
 #include <errno.h>
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#if defined(__linux__)
+#include <sys/vfs.h>
+#endif
 #endif
 
 namespace hope::threading::platform {
 
+    /**
+     * Access pattern hint passed to madvise (ignored where there is no such call).
+     */
+    enum class memory_advice : uint8_t {
+        none,
+        sequential, // MADV_SEQUENTIAL, e.g. a journal read from the beginning to the end
+        random,     // MADV_RANDOM, read ahead is not needed
+        will_need   // MADV_WILLNEED, start reading the pages in now
+    };
+
+    /**
+     * How the segment is backed and prepared, every option is best-effort: the segment is still created
+     * when the option can not be applied, shared_memory_segment tells what was applied.
+     */
+    struct shared_memory_options {
+        /**
+         * Back the segment by huge pages: a file in the hugetlbfs mount \p hugetlbfs_dir (Linux), the size is rounded
+         * up to the huge page size. Falls back to normal pages (asking for transparent huge pages with MADV_HUGEPAGE)
+         * if the mount does not exist or the huge page pool is exhausted.
+         */
+        bool huge_pages{ false };
+        const char* hugetlbfs_dir{ "/dev/hugepages" };
+        /** Fault every page in at creation (MAP_POPULATE, or touching every page), not in the middle of the session. */
+        bool populate{ false };
+        /** mlock the segment, so it is never paged out (needs RLIMIT_MEMLOCK or CAP_IPC_LOCK). */
+        bool lock{ false };
+        memory_advice advice{ memory_advice::none };
+    };
+
     /**
      * Mapped shared memory segment (named POSIX shm or Windows file mapping).
      * Call close_shared_memory when done in each process.
@@ -36,6 +71,12 @@ namespace hope::threading::platform {
     struct shared_memory_segment {
         void* data{ nullptr };
         std::size_t size{ 0 };
+        /** Effective size of the pages backing the segment. */
+        std::size_t page_size{ 0 };
+        /** True if the segment is backed by hugetlbfs pages. */
+        bool huge_pages{ false };
+        /** True if the segment is locked in memory. */
+        bool locked{ false };
 #if defined(_WIN32)
         HANDLE mapping{ nullptr };
 #else
@@ -58,16 +99,32 @@ namespace hope::threading::platform {
                 s.mapping = nullptr;
             }
         }
+
+        // large pages of a named mapping need SeLockMemoryPrivilege, the segment always uses normal pages
+        inline void apply_options(shared_memory_segment& s, const shared_memory_options& options) noexcept {
+            SYSTEM_INFO info{};
+            GetSystemInfo(&info);
+            s.page_size = info.dwPageSize;
+            if (options.populate) {
+                auto* bytes = static_cast<volatile unsigned char*>(s.data);
+                for (std::size_t offset{ 0 }; offset < s.size; offset += s.page_size)
+                    (void)bytes[offset];
+            }
+            if (options.lock)
+                s.locked = VirtualLock(s.data, s.size) != 0;
+        }
     } // namespace detail
 
     /**
      * Creates a named file mapping or opens an existing one, then maps the whole segment.
      * \param name Object name (ASCII). Use a distinct prefix per application (e.g. "Local\\myapp_shm").
      * \param size_bytes Size when creating; if the mapping already exists, \p size_bytes must match its size.
+     * \param options Backing and preparation of the segment, see shared_memory_options.
      * \param out Filled on success; unchanged on failure.
      * \return true on success.
      */
-    inline bool create_or_open_shared_memory(const char* name, std::size_t size_bytes, shared_memory_segment* out) noexcept {
+    inline bool create_or_open_shared_memory(const char* name, std::size_t size_bytes,
+        const shared_memory_options& options, shared_memory_segment* out) noexcept {
         if (!out || !name || size_bytes == 0) {
             return false;
         }
@@ -124,12 +181,23 @@ namespace hope::threading::platform {
         out->size = mapped_size;
         out->mapping = mapping;
         out->created_new = created_new;
+        out->huge_pages = false;
+        out->locked = false;
+        detail::apply_options(*out, options);
         return true;
     }
 
+    inline bool create_or_open_shared_memory(const char* name, std::size_t size_bytes, shared_memory_segment* out) noexcept {
+        return create_or_open_shared_memory(name, size_bytes, shared_memory_options{ }, out);
+    }
+
     inline void close_shared_memory(shared_memory_segment& seg) noexcept {
+        if (seg.locked && seg.data)
+            VirtualUnlock(seg.data, seg.size);
         detail::close_handles(seg);
         seg.size = 0;
+        seg.page_size = 0;
+        seg.locked = false;
         seg.created_new = false;
     }
 
@@ -141,6 +209,10 @@ namespace hope::threading::platform {
         return true;
     }
 
+    inline bool unlink_shared_memory(const char* /*name*/, const shared_memory_options& /*options*/) noexcept {
+        return true;
+    }
+
 #else
 
     namespace detail {
@@ -165,8 +237,8 @@ namespace hope::threading::platform {
             return true;
         }
 
-        inline bool map_fd(int fd, std::size_t map_size, shared_memory_segment* out) {
-            void* p = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        inline bool map_fd(int fd, std::size_t map_size, int extra_flags, shared_memory_segment* out) {
+            void* p = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED | extra_flags, fd, 0);
             if (p == MAP_FAILED) {
                 return false;
             }
@@ -175,6 +247,117 @@ namespace hope::threading::platform {
             out->fd = fd;
             return true;
         }
+
+        inline int populate_flag(const shared_memory_options& options) noexcept {
+#if defined(MAP_POPULATE)
+            return options.populate ? MAP_POPULATE : 0;
+#else
+            (void)options;
+            return 0;
+#endif
+        }
+
+        inline std::size_t system_page_size() noexcept {
+            const long size = ::sysconf(_SC_PAGESIZE);
+            return size > 0 ? static_cast<std::size_t>(size) : 4096;
+        }
+
+#if defined(__linux__)
+        constexpr unsigned long k_hugetlbfs_magic = 0x958458f6;
+
+        // 0 if the directory is not a hugetlbfs mount
+        inline std::size_t huge_page_size(const char* dir) noexcept {
+            struct statfs fs {};
+            if (!dir || ::statfs(dir, &fs) != 0 || static_cast<unsigned long>(fs.f_type) != k_hugetlbfs_magic) {
+                return 0;
+            }
+            return static_cast<std::size_t>(fs.f_bsize);
+        }
+
+        inline bool hugetlbfs_path(const char* name, const shared_memory_options& options, char (&path)[PATH_MAX]) noexcept {
+            const int written = std::snprintf(path, sizeof(path), "%s%s", options.hugetlbfs_dir, name);
+            return written > 0 && static_cast<std::size_t>(written) < sizeof(path);
+        }
+
+        enum class open_result : uint8_t {
+            opened,
+            missing,    // there is no such object (or no hugetlbfs mount), another backing might be tried
+            failed,
+        };
+
+        // the huge pages of a shared mapping are reserved by mmap, so an exhausted pool fails here, not on first touch;
+        // \p create: only a new file is created (O_EXCL), otherwise only an existing one is opened
+        inline open_result open_huge_pages(const char* name, std::size_t size_bytes, const shared_memory_options& options,
+            bool create, shared_memory_segment* out) noexcept {
+            const std::size_t huge_size = huge_page_size(options.hugetlbfs_dir);
+            char path[PATH_MAX];
+            if (huge_size == 0 || !hugetlbfs_path(name, options, path)) {
+                return open_result::missing;
+            }
+
+            const std::size_t map_size = (size_bytes + huge_size - 1) / huge_size * huge_size;
+            const int fd = ::open(path, create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+            if (fd < 0) {
+                return !create && errno == ENOENT ? open_result::missing : open_result::failed;
+            }
+
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                return open_result::failed;
+            }
+
+            const bool created_new = st.st_size == 0;
+            if ((created_new && ::ftruncate(fd, static_cast<off_t>(map_size)) != 0)
+                || static_cast<std::size_t>(created_new ? map_size : st.st_size) < map_size
+                || !map_fd(fd, map_size, populate_flag(options), out)) {
+                ::close(fd);
+                if (created_new) {
+                    ::unlink(path);
+                }
+                return open_result::failed;
+            }
+
+            out->created_new = created_new;
+            out->page_size = huge_size;
+            out->huge_pages = true;
+            return open_result::opened;
+        }
+
+        inline bool shm_exists(const char* name) noexcept {
+            const int fd = ::shm_open(name, O_RDWR, 0600);
+            if (fd < 0) {
+                return false;
+            }
+            ::close(fd);
+            return true;
+        }
+#endif
+
+        inline void apply_options(shared_memory_segment& s, const shared_memory_options& options) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            // transparent huge pages for shmem are used only if the system allows them (shmem_enabled)
+            if (options.huge_pages && !s.huge_pages) {
+                (void)::madvise(s.data, s.size, MADV_HUGEPAGE);
+            }
+#endif
+#if !defined(MAP_POPULATE)
+            if (options.populate) {
+                auto* bytes = static_cast<volatile unsigned char*>(s.data);
+                for (std::size_t offset{ 0 }; offset < s.size; offset += s.page_size)
+                    (void)bytes[offset];
+            }
+#endif
+            switch (options.advice) {
+                case memory_advice::sequential: (void)::madvise(s.data, s.size, MADV_SEQUENTIAL); break;
+                case memory_advice::random: (void)::madvise(s.data, s.size, MADV_RANDOM); break;
+                case memory_advice::will_need: (void)::madvise(s.data, s.size, MADV_WILLNEED); break;
+                case memory_advice::none: break;
+            }
+            if (options.lock) {
+                s.locked = ::mlock(s.data, s.size) == 0;
+            }
+        }
     } // namespace detail
 
     /**
@@ -182,10 +365,16 @@ namespace hope::threading::platform {
      * \param name Must start with '/' (e.g. "/myapp_segment") for portable shm_open.
      *        On macOS the name must be at most 31 characters (including the leading slash).
      * \param size_bytes Size for a new segment; if the object already exists, the existing size is used
-     *        and must match \p size_bytes (otherwise the call fails).
+     *        and must match \p size_bytes (otherwise the call fails). Huge page backed segments are rounded up
+     *        to the huge page size.
+     * \param options Backing and preparation of the segment, see shared_memory_options.
+     *        Every process has to pass the same huge_pages option, the huge page backed segment is another object.
+     *        With huge_pages an existing segment is opened whatever its backing is (the creator might have fallen back
+     *        to normal pages), a new one is created only if neither the hugetlbfs file nor the shm object exists.
      * \param out Filled on success.
      */
-    inline bool create_or_open_shared_memory(const char* name, std::size_t size_bytes, shared_memory_segment* out) noexcept {
+    inline bool create_or_open_shared_memory(const char* name, std::size_t size_bytes,
+        const shared_memory_options& options, shared_memory_segment* out) noexcept {
         if (!out || !name || size_bytes == 0) {
             return false;
         }
@@ -203,6 +392,32 @@ namespace hope::threading::platform {
             return false;
         }
 
+        out->huge_pages = false;
+        out->locked = false;
+#if defined(__linux__)
+        if (options.huge_pages) {
+            // an existing huge page backed segment is never replaced by another object
+            auto result = detail::open_huge_pages(name, size_bytes, options, false, out);
+            if (result == detail::open_result::missing && !detail::shm_exists(name)) {
+                result = detail::open_huge_pages(name, size_bytes, options, true, out);
+                if (result == detail::open_result::failed && errno == EEXIST) {
+                    // another process has just created it
+                    result = detail::open_huge_pages(name, size_bytes, options, false, out);
+                    if (result != detail::open_result::opened) {
+                        return false;
+                    }
+                }
+            } else if (result == detail::open_result::failed) {
+                return false;
+            }
+            if (result == detail::open_result::opened) {
+                detail::apply_options(*out, options);
+                return true;
+            }
+            // the creator fell back (or falls back now) to normal pages
+        }
+#endif
+
         for (int attempt = 0; attempt < 2; ++attempt) {
             const int fd = ::shm_open(name, O_RDWR | O_CREAT, 0600);
             if (fd < 0) {
@@ -234,20 +449,29 @@ namespace hope::threading::platform {
                 return false;
             }
 
-            if (!detail::map_fd(fd, size_bytes, out)) {
+            if (!detail::map_fd(fd, size_bytes, detail::populate_flag(options), out)) {
                 ::close(fd);
                 return false;
             }
 
             out->created_new = created_new;
+            out->page_size = detail::system_page_size();
+            detail::apply_options(*out, options);
             return true;
         }
 
         return false;
     }
 
+    inline bool create_or_open_shared_memory(const char* name, std::size_t size_bytes, shared_memory_segment* out) noexcept {
+        return create_or_open_shared_memory(name, size_bytes, shared_memory_options{ }, out);
+    }
+
     inline void close_shared_memory(shared_memory_segment& seg) noexcept {
         if (seg.data && seg.size > 0) {
+            if (seg.locked) {
+                ::munlock(seg.data, seg.size);
+            }
             ::munmap(seg.data, seg.size);
         }
         if (seg.fd >= 0) {
@@ -255,6 +479,9 @@ namespace hope::threading::platform {
         }
         seg.data = nullptr;
         seg.size = 0;
+        seg.page_size = 0;
+        seg.huge_pages = false;
+        seg.locked = false;
         seg.fd = -1;
         seg.created_new = false;
     }
@@ -266,6 +493,26 @@ namespace hope::threading::platform {
         return ::shm_unlink(name) == 0;
     }
 
+    /**
+     * Removes both the shm object and the hugetlbfs file the segment might have been placed to.
+     * \return true if any of them was removed.
+     */
+    inline bool unlink_shared_memory(const char* name, const shared_memory_options& options) noexcept {
+        if (!name) {
+            return false;
+        }
+        bool removed = ::shm_unlink(name) == 0;
+#if defined(__linux__)
+        char path[PATH_MAX];
+        if (options.huge_pages && detail::hugetlbfs_path(name, options, path)) {
+            removed = ::unlink(path) == 0 || removed;
+        }
+#else
+        (void)options;
+#endif
+        return removed;
+    }
+
 #endif
 
 } // namespace hope::threading::platform
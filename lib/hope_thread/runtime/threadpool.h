@@ -17,7 +17,7 @@
 
 #include "hope_thread/synchronization/event.h"
 #include "hope_thread/synchronization/spinlock.h"
-#include "hope_thread/containers/queue/mpmc_bounded_queue.h"
+#include "hope_thread/core/object_pool.h"
 
 // todo:: even not tested yet, idk what the code is going here...
 namespace hope::threading {
@@ -105,6 +105,8 @@ namespace hope::threading {
                 const std::lock_guard lock(m_queue_guard);
                 m_time_to_die.store(true, std::memory_order_release);
                 // Clean up all queued objects
+                for (auto* w : m_queued_work)
+                    m_work_wrapper_pool.destroy(w);
                 m_queued_work.clear();
             }
 
@@ -122,10 +124,6 @@ namespace hope::threading {
             for (const auto* thread : m_all_threads)
                 delete thread;
 
-            work_wrapper* w;
-            while (m_work_wrapper_pool.try_dequeue(w))
-                delete w;
-
             m_free_threads.clear();
             m_all_threads.clear();
         }
@@ -134,12 +132,7 @@ namespace hope::threading {
             if (m_time_to_die.load(std::memory_order_acquire))
                 return;
 
-            work_wrapper* queued_work = nullptr;
-            if (!m_work_wrapper_pool.try_dequeue(queued_work)){
-                queued_work = new work_wrapper;
-            }
-
-            queued_work->work_impl = std::move(w);
+            auto* queued_work = m_work_wrapper_pool.create(std::move(w));
             m_queue_guard.lock();
             if (m_free_threads.empty()) {
                 // No thread available, queue the work to be done
@@ -171,11 +164,11 @@ namespace hope::threading {
         }
 
         void return_wrapper_to_pool(work_wrapper* w){
-            const auto success = m_work_wrapper_pool.try_enqueue(w);
-            assert(success);
+            m_work_wrapper_pool.destroy(w);
         }
 
-        mpmc_bounded_queue<work_wrapper*> m_work_wrapper_pool{1024 };
+        /** Wrappers are recycled through the thread local caches, there is no cap on the count of tasks in flight. */
+        object_pool<work_wrapper> m_work_wrapper_pool;
 
         /** The work queue to pull from. */
         std::deque<work_wrapper*> m_queued_work;
@@ -9,7 +9,10 @@
 #pragma once
 
 #include <functional>
+#include <span>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "hope_thread/containers/queue/mpsc_queue.h"
 #include "hope_thread/synchronization/event.h"
@@ -51,6 +54,8 @@ namespace hope::threading {
         std::atomic_bool m_work_added{ false };
     };
 
+    // the payload is called either for every item, or, if it accepts std::span<TData>,
+    // once per wakeup with the whole drained batch
     template<typename TPayload, typename TData>
     class async_worker_impl final : public async_worker<TData> {
     public:
@@ -63,18 +68,38 @@ namespace hope::threading {
         async_worker_impl() = default;
 
     private:
-        virtual void run(std::stop_token token) override {
-            while(!token.stop_requested()) {
-                TData queued;
-                while(this->m_queued_work.try_dequeue(queued))
-                    m_payload(std::move(queued));
+        constexpr static bool batched = std::is_invocable_v<TPayload&, std::span<TData>>;
 
-                this->m_work_added.store(false, std::memory_order_release);
+        virtual void run(std::stop_token token) override {
+            for (;;) {
+                // reset the flag before draining, otherwise the work added during the drain might be missed;
+                // acquire pairs with stop(), so the stop request is visible below once its flag is consumed
+                (void)this->m_work_added.exchange(false, std::memory_order_acquire);
+
+                if constexpr (batched) {
+                    this->m_queued_work.consume_all([this](TData&& queued) {
+                        m_batch.push_back(std::move(queued));
+                    });
+                    if (!m_batch.empty()) {
+                        m_payload(std::span<TData>(m_batch));
+                        m_batch.clear();
+                    }
+                } else {
+                    this->m_queued_work.consume_all([this](TData&& queued) {
+                        m_payload(std::move(queued));
+                    });
+                }
+
+                if (token.stop_requested())
+                    break;
                 this->m_work_added.wait(false, std::memory_order_acquire);
             }
         }
 
         TPayload m_payload;
+
+        // keeps its capacity between the wakeups
+        std::vector<TData> m_batch;
     };
 
     template<typename TQueued, typename TPayload>
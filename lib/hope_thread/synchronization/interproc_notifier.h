@@ -0,0 +1,78 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "hope_thread/platform/futex.h"
+#include "hope_thread/synchronization/backoff.h"
+#include "hope_thread/foundation.h"
+
+namespace hope::threading {
+
+    // wait/notify word for the queues living in shared memory, it is placed in the segment next to the queue;
+    // a consumer spins on its condition for a while, then announces itself in m_waiters and sleeps on the shared
+    // futex, the producer calls notify() after every publish, which costs a fence and a load of m_waiters
+    // while nobody sleeps, the syscall is made only if somebody does;
+    // all zeros is a valid state, so a zero filled segment does not need a constructor to run
+    //     producer:  queue->try_enqueue(v); notifier->notify();
+    //     consumer:  notifier->wait([&] { return reader.try_dequeue(v); });
+    class alignas(CACHE_LINE_SIZE) interproc_notifier final {
+    public:
+        HOPE_THREADING_CONSTRUCTABLE_ONLY(interproc_notifier)
+
+        interproc_notifier() = default;
+        ~interproc_notifier() = default;
+
+        // returns once ready() is true, ready() is called on every wake up, so it might consume the item
+        template<typename F>
+        void wait(F&& ready, std::size_t spin_count = default_spin_count) {
+            for (std::size_t i{ 0 }; i < spin_count; ++i) {
+                if (ready())
+                    return;
+                SYSTEM_PAUSE;
+            }
+
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            // pairs with the fence of notify: either the producer sees the waiter or ready() sees the item
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            for (;;) {
+                // the epoch is read before the condition, a notify in between makes the futex return at once
+                const auto epoch = m_epoch.load(std::memory_order_acquire);
+                if (ready())
+                    break;
+                platform::futex_wait(m_epoch, epoch);
+            }
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // called by the producer after the item is published
+        void notify() noexcept {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_waiters.load(std::memory_order_relaxed) == 0)
+                return;
+            m_epoch.fetch_add(1, std::memory_order_release);
+            platform::futex_wake_all(m_epoch);
+        }
+
+        // count of the consumers sleeping (or about to sleep) at the moment
+        uint32_t waiters() const noexcept {
+            return m_waiters.load(std::memory_order_relaxed);
+        }
+
+        constexpr static std::size_t default_spin_count = 4096;
+
+    private:
+        std::atomic<uint32_t> m_epoch{ 0 };
+        std::atomic<uint32_t> m_waiters{ 0 };
+    };
+
+}
@@ -0,0 +1,108 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "hope_thread/synchronization/backoff.h"
+#include "hope_thread/foundation.h"
+
+// building blocks of the Disruptor-like rings: every party (producer, consumer, pipeline stage)
+// publishes its progress as a monotonic sequence in a cache line of its own, the others gate on it;
+// the wait strategy decides what a party does while the sequence it gates on does not move:
+//     strategy.wait(word, ready);   // returns once ready() is true, word is the sequence ready() depends on
+//     strategy.notify(word);        // called by the owner of the word after every store to it
+
+namespace hope::threading {
+
+    struct alignas(CACHE_LINE_SIZE) padded_sequence final {
+        std::atomic<std::size_t> value{ 0 };
+    };
+
+    // lowest latency, burns the core while waiting
+    struct busy_spin_wait final {
+        template<typename F>
+        void wait(const std::atomic<std::size_t>&, F&& ready) const {
+            while (!ready())
+                SYSTEM_PAUSE;
+        }
+
+        void notify(std::atomic<std::size_t>&) const noexcept { }
+    };
+
+    // spins for a while, then gives the rest of the time slice away on every check
+    struct yielding_wait final {
+        template<typename F>
+        void wait(const std::atomic<std::size_t>&, F&& ready) const {
+            for (std::size_t i{ 0 }; !ready(); ++i) {
+                if (i < spin_count)
+                    SYSTEM_PAUSE;
+                else
+                    std::this_thread::yield();
+            }
+        }
+
+        void notify(std::atomic<std::size_t>&) const noexcept { }
+
+        constexpr static std::size_t spin_count = 128;
+    };
+
+    // spins for a while, then sleeps in std::atomic::wait on the word until its owner changes it;
+    // the owner pays for notify_all after every store, which does not enter the kernel while nobody sleeps
+    struct parking_wait final {
+        template<typename F>
+        void wait(const std::atomic<std::size_t>& word, F&& ready) const {
+            for (std::size_t i{ 0 }; i < spin_count; ++i) {
+                if (ready())
+                    return;
+                SYSTEM_PAUSE;
+            }
+            for (;;) {
+                // the word is read before the predicate, so any change after the check wakes us up
+                const auto observed = word.load(std::memory_order_acquire);
+                if (ready())
+                    return;
+                word.wait(observed, std::memory_order_acquire);
+            }
+        }
+
+        void notify(std::atomic<std::size_t>& word) const noexcept {
+            word.notify_all();
+        }
+
+        constexpr static std::size_t spin_count = 128;
+    };
+
+    // waits until every sequence of the group reaches target, returns the lowest of them;
+    // the waiter sleeps on the slowest sequence and chooses the slowest one again once it moves,
+    // since several sequences might be equally behind
+    template<typename TWaitStrategy, typename TSequences>
+    std::size_t wait_for_all(const TWaitStrategy& strategy, const TSequences& sequences, std::size_t target) {
+        for (;;) {
+            const std::atomic<std::size_t>* slowest{ nullptr };
+            auto lowest = SIZE_MAX;
+            for (const std::atomic<std::size_t>* sequence : sequences) {
+                const auto value = sequence->load(std::memory_order_acquire);
+                if (value < lowest) {
+                    lowest = value;
+                    slowest = sequence;
+                }
+            }
+            if (slowest == nullptr || lowest >= target)
+                return lowest;
+            strategy.wait(*slowest, [&] {
+                return slowest->load(std::memory_order_acquire) != lowest;
+            });
+        }
+    }
+
+}
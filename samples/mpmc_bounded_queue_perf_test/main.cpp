@@ -0,0 +1,141 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/mpmc_bounded_queue.h"
+#include "hope_thread/containers/queue/mpmc_queue.h"
+
+using namespace hope::threading;
+
+// compares padded and packed layouts of the mpmc_bounded_queue:
+// memory occupied by the ring and throughput of the producers/consumers pumping items through it,
+// the unbounded mpmc_queue is measured the same way as a reference
+template<typename TQueue>
+void run_test(const char* name, std::size_t capacity, std::size_t producers, std::size_t consumers, std::size_t items) {
+    TQueue queue(capacity);
+
+    // touch the whole ring once, page faults should not be measured
+    for (std::size_t i{ 0 }; i < capacity; ++i)
+        (void)queue.try_enqueue(i);
+    std::size_t dummy;
+    while (queue.try_dequeue(dummy)) { }
+
+    std::atomic<std::size_t> consumed{ 0 };
+    std::atomic<bool> start{ false };
+    std::vector<std::thread> ts;
+
+    const std::size_t items_per_producer = items / producers;
+    const std::size_t total = items_per_producer * producers;
+
+    for (std::size_t p{ 0 }; p < producers; ++p) {
+        ts.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) { }
+            for (std::size_t i{ 0 }; i < items_per_producer; ++i) {
+                while (!queue.try_enqueue(i))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    for (std::size_t c{ 0 }; c < consumers; ++c) {
+        ts.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) { }
+            std::size_t v;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (queue.try_dequeue(v))
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    auto&& begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto&& t : ts)
+        t.join();
+    auto&& elapsed = std::chrono::steady_clock::now() - begin;
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    const double mops = double(total) / (double)std::max<long long>(ms, 1) / 1000.0;
+    std::cout << name
+        << " capacity: " << capacity
+        << " memory: " << queue.storage_size() / 1024 << " KB"
+        << " producers: " << producers
+        << " consumers: " << consumers
+        << " time: " << ms << " ms"
+        << " throughput: " << mops << " Mops/s" << std::endl;
+}
+
+void run_unbounded_test(std::size_t producers, std::size_t consumers, std::size_t items) {
+    mpmc_queue<std::size_t> queue;
+
+    std::atomic<std::size_t> consumed{ 0 };
+    std::atomic<bool> start{ false };
+    std::vector<std::thread> ts;
+
+    const std::size_t items_per_producer = items / producers;
+    const std::size_t total = items_per_producer * producers;
+
+    for (std::size_t p{ 0 }; p < producers; ++p) {
+        ts.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) { }
+            for (std::size_t i{ 0 }; i < items_per_producer; ++i)
+                queue.enqueue(i);
+        });
+    }
+
+    for (std::size_t c{ 0 }; c < consumers; ++c) {
+        ts.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) { }
+            std::size_t v;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (queue.try_dequeue(v))
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    auto&& begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto&& t : ts)
+        t.join();
+    auto&& elapsed = std::chrono::steady_clock::now() - begin;
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    const double mops = double(total) / (double)std::max<long long>(ms, 1) / 1000.0;
+    std::cout << "unbounded"
+        << " producers: " << producers
+        << " consumers: " << consumers
+        << " time: " << ms << " ms"
+        << " throughput: " << mops << " Mops/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t capacity = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1 << 20);
+    const std::size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+    const std::size_t items = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10'000'000;
+
+    using padded_t = mpmc_bounded_queue<std::size_t, mpmc_layout::padded>;
+    using packed_t = mpmc_bounded_queue<std::size_t, mpmc_layout::packed>;
+
+    for (std::size_t count : { std::size_t(1), threads }) {
+        run_test<padded_t>("padded", capacity, count, count, items);
+        run_test<packed_t>("packed", capacity, count, count, items);
+        run_unbounded_test(count, count, items);
+    }
+}
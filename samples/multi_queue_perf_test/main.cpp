@@ -0,0 +1,129 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/multi_queue.h"
+#include "hope_thread/synchronization/spinlock.h"
+
+using namespace hope::threading;
+
+// the baseline: a single heap behind the spinlock
+class locked_priority_queue final {
+public:
+    explicit locked_priority_queue(std::size_t) { }
+
+    void push(uint64_t priority, uint64_t value) {
+        std::lock_guard lk(m_lock);
+        m_queue.emplace(priority, value);
+    }
+
+    bool try_pop(uint64_t& priority, uint64_t& value) {
+        std::lock_guard lk(m_lock);
+        if (m_queue.empty())
+            return false;
+        priority = m_queue.top().first;
+        value = m_queue.top().second;
+        m_queue.pop();
+        return true;
+    }
+
+private:
+    spinlock m_lock;
+    std::priority_queue<std::pair<uint64_t, uint64_t>> m_queue;
+};
+
+// throughput: every thread does push/pop pairs over a prefilled queue;
+// quality: the prefilled distinct priorities are popped concurrently, every pop takes a ticket,
+// the exact queue hands out priority (n - 1 - ticket), the distance to it is the rank error of the pop
+template<typename TQueue>
+void run_test(const char* name, std::size_t threads, std::size_t prefill, std::size_t operations) {
+    TQueue queue(threads);
+    std::mt19937_64 rng(42);
+    for (std::size_t i{ 0 }; i < prefill; ++i)
+        queue.push(rng() % (prefill * 16), i);
+
+    std::atomic<bool> start{ false };
+    std::vector<std::thread> ts;
+    for (std::size_t t{ 0 }; t < threads; ++t) {
+        ts.emplace_back([&, t] {
+            std::mt19937_64 local_rng(t + 1);
+            while (!start.load(std::memory_order_acquire)) { }
+            uint64_t priority, value;
+            for (std::size_t i{ 0 }; i < operations / threads; ++i) {
+                queue.push(local_rng() % (prefill * 16), i);
+                (void)queue.try_pop(priority, value);
+            }
+        });
+    }
+
+    auto&& begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto&& t : ts)
+        t.join();
+    auto&& elapsed = std::chrono::steady_clock::now() - begin;
+
+    // drain, then measure the quality on a fresh set of distinct priorities
+    uint64_t priority, value;
+    while (queue.try_pop(priority, value)) { }
+    for (std::size_t i{ 0 }; i < prefill; ++i)
+        queue.push(i, i);
+
+    std::atomic<std::size_t> ticket{ 0 };
+    std::atomic<uint64_t> total_error{ 0 };
+    std::atomic<uint64_t> max_error{ 0 };
+    ts.clear();
+    for (std::size_t t{ 0 }; t < threads; ++t) {
+        ts.emplace_back([&] {
+            uint64_t p, v;
+            uint64_t local_total{ 0 };
+            uint64_t local_max{ 0 };
+            while (queue.try_pop(p, v)) {
+                const auto expected = prefill - 1 - ticket.fetch_add(1, std::memory_order_relaxed);
+                const auto error = p > expected ? p - expected : expected - p;
+                local_total += error;
+                local_max = std::max(local_max, error);
+            }
+            total_error.fetch_add(local_total, std::memory_order_relaxed);
+            auto cur_max = max_error.load(std::memory_order_relaxed);
+            while (cur_max < local_max && !max_error.compare_exchange_weak(cur_max, local_max)) { }
+        });
+    }
+    for (auto&& t : ts)
+        t.join();
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    const double mops = double(operations / threads * threads * 2) / (double)std::max<long long>(ms, 1) / 1000.0;
+    std::cout << name
+        << " threads: " << threads
+        << " time: " << ms << " ms"
+        << " throughput: " << mops << " Mops/s"
+        << " mean rank error: " << double(total_error.load()) / double(prefill)
+        << " max rank error: " << max_error.load() << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4;
+    const std::size_t operations = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4'000'000;
+    const std::size_t prefill = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100'000;
+
+    for (std::size_t count : { std::size_t(1), threads }) {
+        run_test<locked_priority_queue>("locked", count, prefill, operations);
+        run_test<multi_queue<uint64_t, uint64_t>>("multi_queue", count, prefill, operations);
+    }
+}
@@ -0,0 +1,83 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/work_stealing_deque.h"
+
+using namespace hope::threading;
+
+// the owner pushes batches of tasks and pops them back, thieves steal concurrently;
+// measures how many tasks per second go through the deque and how many of them were stolen
+void run_test(std::size_t thieves, std::size_t items, std::size_t batch) {
+    work_stealing_deque<std::size_t> deque(64);
+
+    std::atomic<std::size_t> stolen{ 0 };
+    std::atomic<bool> start{ false };
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> ts;
+
+    for (std::size_t t{ 0 }; t < thieves; ++t) {
+        ts.emplace_back([&] {
+            while (!start.load(std::memory_order_acquire)) { }
+            std::size_t v;
+            std::size_t local{ 0 };
+            while (!done.load(std::memory_order_acquire)) {
+                if (deque.steal(v))
+                    ++local;
+                else
+                    std::this_thread::yield();
+            }
+            while (deque.steal(v))
+                ++local;
+            stolen.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    auto&& begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+
+    std::size_t popped{ 0 };
+    std::size_t v;
+    for (std::size_t i{ 0 }; i < items; i += batch) {
+        for (std::size_t j{ 0 }; j < batch && i + j < items; ++j)
+            deque.push(i + j);
+        while (deque.pop(v))
+            ++popped;
+    }
+    done.store(true, std::memory_order_release);
+    for (auto&& t : ts)
+        t.join();
+    auto&& elapsed = std::chrono::steady_clock::now() - begin;
+
+    const auto total = popped + stolen.load(std::memory_order_relaxed);
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    const double mops = double(total) / (double)std::max<long long>(ms, 1) / 1000.0;
+    std::cout << "thieves: " << thieves
+        << " batch: " << batch
+        << " tasks: " << total
+        << " stolen: " << stolen.load(std::memory_order_relaxed)
+        << " capacity: " << deque.capacity()
+        << " time: " << ms << " ms"
+        << " throughput: " << mops << " Mops/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4;
+    const std::size_t items = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10'000'000;
+    const std::size_t batch = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 256;
+
+    for (std::size_t count : { std::size_t(0), std::size_t(1), threads })
+        run_test(count, items, batch);
+}
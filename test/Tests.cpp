@@ -10,6 +10,7 @@
 #include <cassert>
 #include <chrono>
 #include <iostream>
+#include <span>
 
 #include "hope_thread/runtime/worker_thread.h"
 
@@ -19,6 +20,27 @@ void run_async_worker_tests();
 void run_seq_lock_tests();
 void run_spmc_bounded_message_queue_tests();
 void run_spmc_bounded_non_uniform_queue_tests();
+void run_mpmc_bounded_queue_tests();
+void run_spsc_bounded_queue_tests();
+void run_intrusive_mpsc_queue_tests();
+void run_mpsc_queue_tests();
+void run_mpmc_bounded_non_uniform_queue_tests();
+void run_work_stealing_deque_tests();
+void run_mpmc_queue_tests();
+void run_multi_queue_tests();
+void run_reclamation_tests();
+void run_treiber_stack_tests();
+void run_object_pool_tests();
+void run_slab_allocator_tests();
+void run_queue_instrumentation_tests();
+void run_spmc_broadcast_queue_tests();
+void run_pipeline_ring_tests();
+void run_shm_mpmc_bounded_queue_tests();
+void run_interproc_notifier_tests();
+void run_shared_memory_tests();
+void run_segment_header_tests();
+void run_journal_queue_tests();
+void run_typed_message_queue_tests();
 void run_interproc_test();
 void run_interproc_bounded_non_uniform_queue_test();
 
@@ -36,6 +58,48 @@ int main()
     run_spmc_bounded_message_queue_tests();
     std::cerr << "Running spmc_bounded_non_uniform_queue tests..." << std::endl;
     run_spmc_bounded_non_uniform_queue_tests();
+    std::cerr << "Running mpmc_bounded_queue tests..." << std::endl;
+    run_mpmc_bounded_queue_tests();
+    std::cerr << "Running spsc_bounded_queue tests..." << std::endl;
+    run_spsc_bounded_queue_tests();
+    std::cerr << "Running intrusive_mpsc_queue tests..." << std::endl;
+    run_intrusive_mpsc_queue_tests();
+    std::cerr << "Running mpsc_queue tests..." << std::endl;
+    run_mpsc_queue_tests();
+    std::cerr << "Running mpmc_bounded_non_uniform_queue tests..." << std::endl;
+    run_mpmc_bounded_non_uniform_queue_tests();
+    std::cerr << "Running work_stealing_deque tests..." << std::endl;
+    run_work_stealing_deque_tests();
+    std::cerr << "Running mpmc_queue tests..." << std::endl;
+    run_mpmc_queue_tests();
+    std::cerr << "Running multi_queue tests..." << std::endl;
+    run_multi_queue_tests();
+    std::cerr << "Running reclamation tests..." << std::endl;
+    run_reclamation_tests();
+    std::cerr << "Running treiber_stack tests..." << std::endl;
+    run_treiber_stack_tests();
+    std::cerr << "Running object_pool tests..." << std::endl;
+    run_object_pool_tests();
+    std::cerr << "Running slab_allocator tests..." << std::endl;
+    run_slab_allocator_tests();
+    std::cerr << "Running queue instrumentation tests..." << std::endl;
+    run_queue_instrumentation_tests();
+    std::cerr << "Running spmc_broadcast_queue tests..." << std::endl;
+    run_spmc_broadcast_queue_tests();
+    std::cerr << "Running pipeline_ring tests..." << std::endl;
+    run_pipeline_ring_tests();
+    std::cerr << "Running shm_mpmc_bounded_queue tests..." << std::endl;
+    run_shm_mpmc_bounded_queue_tests();
+    std::cerr << "Running interproc_notifier tests..." << std::endl;
+    run_interproc_notifier_tests();
+    std::cerr << "Running shared_memory tests..." << std::endl;
+    run_shared_memory_tests();
+    std::cerr << "Running segment_header tests..." << std::endl;
+    run_segment_header_tests();
+    std::cerr << "Running journal_queue tests..." << std::endl;
+    run_journal_queue_tests();
+    std::cerr << "Running typed_message_queue tests..." << std::endl;
+    run_typed_message_queue_tests();
     std::cout << "Running interproc tests..." << std::endl;
     run_interproc_test();
     run_interproc_bounded_non_uniform_queue_test();
@@ -110,4 +174,38 @@ void run_async_worker_tests() {
         worker.stop();
         worker.stop();
     }
+
+    {
+        std::atomic<int> processed{ 0 };
+        std::atomic<int> batches{ 0 };
+        std::atomic<bool> ordered{ true };
+        int last = 0;
+
+        auto worker = hope::threading::async_worker_impl(
+            [&](std::span<int> batch) {
+                batches.fetch_add(1, std::memory_order_relaxed);
+                for (auto v : batch) {
+                    if (v != last + 1) {
+                        ordered.store(false, std::memory_order_relaxed);
+                    }
+                    last = v;
+                }
+                processed.fetch_add((int)batch.size(), std::memory_order_relaxed);
+            }, int{}
+        );
+
+        constexpr int items = 5000;
+        for (int i = 1; i <= items; ++i) {
+            worker.add(i);
+        }
+
+        const bool all_processed = wait_until([&processed] {
+            return processed.load(std::memory_order_relaxed) == items;
+        }, std::chrono::milliseconds(2000));
+
+        assert(all_processed);
+        assert(ordered.load(std::memory_order_relaxed));
+        assert(batches.load(std::memory_order_relaxed) <= items);
+        worker.stop();
+    }
 }
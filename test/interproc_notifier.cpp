@@ -0,0 +1,67 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/synchronization/interproc_notifier.h"
+
+void run_interproc_notifier_tests()
+{
+    // nobody sleeps - notify does not enter the kernel, the condition is checked before sleeping
+    {
+        hope::threading::interproc_notifier n;
+        n.notify();
+        assert(n.waiters() == 0);
+        int calls = 0;
+        n.wait([&] { return ++calls == 3; });
+        assert(calls == 3 && n.waiters() == 0);
+    }
+
+    // the consumer goes to sleep after the spin and is woken up by the producer
+    if constexpr (hope::threading::platform::has_shared_futex) {
+        hope::threading::interproc_notifier n;
+        std::atomic<int> item{ 0 };
+        std::thread consumer([&] {
+            n.wait([&] { return item.load(std::memory_order_acquire) != 0; }, 16);
+        });
+        while (n.waiters() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        item.store(1, std::memory_order_release);
+        n.notify();
+        consumer.join();
+        assert(n.waiters() == 0);
+    }
+
+    // ping-pong, every publish is seen
+    {
+        hope::threading::interproc_notifier n;
+        std::atomic<int> published{ 0 };
+        constexpr int k_items = 20000;
+        std::vector<std::thread> ts;
+        std::atomic<int> seen{ 0 };
+        ts.emplace_back([&] {
+            for (int i = 1; i <= k_items; ++i) {
+                n.wait([&] { return published.load(std::memory_order_acquire) >= i; }, 64);
+            }
+            seen.store(k_items);
+        });
+        for (int i = 1; i <= k_items; ++i) {
+            published.store(i, std::memory_order_release);
+            n.notify();
+        }
+        for (auto&& t : ts) {
+            t.join();
+        }
+        assert(seen.load() == k_items);
+    }
+}
@@ -0,0 +1,93 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/intrusive_mpsc_queue.h"
+
+namespace {
+
+    struct message final : hope::threading::mpsc_hook {
+        int producer{ 0 };
+        int value{ 0 };
+    };
+
+} // namespace
+
+void run_intrusive_mpsc_queue_tests()
+{
+    using queue_t = hope::threading::intrusive_mpsc_queue<message>;
+
+    {
+        queue_t q;
+        assert(q.empty());
+        assert(q.try_dequeue() == nullptr);
+
+        message a, b, c;
+        a.value = 1;
+        b.value = 2;
+        c.value = 3;
+        q.enqueue(&a);
+        assert(!q.empty());
+        q.enqueue(&b);
+        assert(q.try_dequeue() == &a);
+        assert(q.try_dequeue() == &b);
+        assert(q.empty());
+        assert(q.try_dequeue() == nullptr);
+
+        // the same objects might be linked again once they are dequeued
+        q.enqueue(&b);
+        q.enqueue(&c);
+        q.enqueue(&a);
+        assert(q.try_dequeue() == &b);
+        assert(q.try_dequeue() == &c);
+        assert(q.try_dequeue() == &a);
+        assert(q.try_dequeue() == nullptr);
+    }
+
+    // every producer owns its messages, per producer order has to be preserved
+    {
+        constexpr int k_producers = 4;
+        constexpr int k_items = 20000;
+
+        queue_t q;
+        std::vector<std::vector<message>> messages(k_producers, std::vector<message>(k_items));
+        std::vector<std::thread> producers;
+        for (int p = 0; p < k_producers; ++p) {
+            producers.emplace_back([&, p] {
+                for (int i = 0; i < k_items; ++i) {
+                    auto& m = messages[p][i];
+                    m.producer = p;
+                    m.value = i;
+                    q.enqueue(&m);
+                }
+            });
+        }
+
+        std::vector<int> expected(k_producers, 0);
+        int received = 0;
+        while (received < k_producers * k_items) {
+            auto* m = q.try_dequeue();
+            if (m == nullptr) {
+                std::this_thread::yield();
+                continue;
+            }
+            assert(m->value == expected[m->producer]);
+            ++expected[m->producer];
+            ++received;
+        }
+
+        for (auto&& t : producers) {
+            t.join();
+        }
+        assert(q.try_dequeue() == nullptr);
+        assert(q.empty());
+    }
+}
@@ -0,0 +1,250 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include "hope_thread/containers/queue/journal_queue.h"
+
+namespace {
+
+    // the message of the sequence number is its size (1..64 bytes) filled with the number
+    std::size_t message_size(uint64_t sequence) {
+        return sequence % 64 + 1;
+    }
+
+    void append_message(hope::threading::journal_writer& writer, uint64_t sequence) {
+        assert(writer.sequence() == sequence);
+        const auto ok = writer.append(message_size(sequence), [sequence](uint8_t* payload) {
+            std::memset(payload, static_cast<int>(sequence & 0xff), message_size(sequence));
+        });
+        assert(ok);
+        (void)ok;
+    }
+
+    bool read_message(hope::threading::journal_reader& reader, uint64_t sequence) {
+        assert(reader.sequence() == sequence);
+        return reader.try_read([sequence](const uint8_t* payload, std::size_t size) {
+            assert(size == message_size(sequence));
+            for (std::size_t i = 0; i < size; ++i) {
+                assert(payload[i] == (sequence & 0xff));
+            }
+        });
+    }
+
+    std::string prepare_directory(const char* name) {
+        const auto directory = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(directory);
+        return directory.string();
+    }
+
+} // namespace
+
+void run_journal_queue_tests()
+{
+    // rolling files, reading from the beginning, seeking, recovery of the writer
+    {
+        const auto directory = prepare_directory("hope_journal_test");
+        hope::threading::journal_options options;
+        options.directory = directory.c_str();
+        options.name = "orders";
+        options.roll_size = 4096;
+        options.index_spacing = 4;
+        options.background = false;
+
+        constexpr uint64_t k_count = 1000;
+        {
+            hope::threading::journal_writer writer;
+            assert(writer.open(options));
+            for (uint64_t i = 0; i < k_count; ++i) {
+                append_message(writer, i);
+            }
+            assert(writer.cycle() > 5);
+            // does not fit any file
+            assert(!writer.append(writer.max_payload() + 1, [](uint8_t*) { }));
+        }
+
+        hope::threading::journal_reader reader;
+        assert(reader.open(options));
+        for (uint64_t i = 0; i < k_count; ++i) {
+            assert(read_message(reader, i));
+        }
+        assert(!reader.try_read([](const uint8_t*, std::size_t) { assert(false); }));
+
+        for (uint64_t target : { uint64_t(0), uint64_t(3), uint64_t(4), uint64_t(517), k_count - 1 }) {
+            assert(reader.seek(target));
+            assert(read_message(reader, target));
+        }
+        assert(!reader.seek(k_count));
+
+        // the writer continues after the last message, the reader at the end tails it
+        hope::threading::journal_writer writer;
+        assert(writer.open(options));
+        assert(writer.sequence() == k_count);
+        for (uint64_t i = k_count; i < 2 * k_count; ++i) {
+            append_message(writer, i);
+        }
+        for (uint64_t i = k_count; i < 2 * k_count; ++i) {
+            assert(read_message(reader, i));
+        }
+        assert(reader.seek(k_count + 1));
+        assert(read_message(reader, k_count + 1));
+        writer.close();
+        reader.close();
+        std::filesystem::remove_all(directory);
+    }
+
+    // reopened with other options the writer keeps the ones of the journal, a foreign file is never overwritten
+    {
+        const auto directory = prepare_directory("hope_journal_options_test");
+        hope::threading::journal_options options;
+        options.directory = directory.c_str();
+        options.roll_size = 1 << 20;
+        options.index_spacing = 8;
+        options.background = false;
+
+        constexpr uint64_t k_count = 100;
+        {
+            hope::threading::journal_writer writer;
+            assert(writer.open(options));
+            for (uint64_t i = 0; i < k_count; ++i) {
+                append_message(writer, i);
+            }
+        }
+
+        options.roll_size = 1 << 16;
+        options.index_spacing = 3;
+        {
+            hope::threading::journal_writer writer;
+            assert(writer.open(options));
+            assert(writer.sequence() == k_count && writer.cycle() == 0);
+            append_message(writer, k_count);
+        }
+
+        hope::threading::journal_reader reader;
+        assert(reader.open(options));
+        for (uint64_t i = 0; i <= k_count; ++i) {
+            assert(read_message(reader, i));
+        }
+        assert(!reader.try_read([](const uint8_t*, std::size_t) { assert(false); }));
+        for (uint64_t target : { uint64_t(0), uint64_t(7), uint64_t(8), uint64_t(95), k_count }) {
+            assert(reader.seek(target));
+            assert(read_message(reader, target));
+        }
+        reader.close();
+
+        // the last file is not a journal file: open fails and leaves it as it is
+        const auto last = std::filesystem::path(directory) / "journal.00000001.journal";
+        {
+            std::FILE* file = std::fopen(last.string().c_str(), "wb");
+            assert(file);
+            const char garbage[256] = "not a journal";
+            std::fwrite(garbage, 1, sizeof(garbage), file);
+            std::fclose(file);
+        }
+        {
+            hope::threading::journal_writer writer;
+            assert(!writer.open(options));
+            assert(!writer.valid());
+        }
+        assert(std::filesystem::file_size(last) == 256);
+        std::filesystem::remove_all(directory);
+    }
+
+    // a writer crashed in the middle of append: the payload is there, its size word is not;
+    // the next writer overwrites it and the stale bytes are never taken for a frame
+    {
+        const auto directory = prepare_directory("hope_journal_crash_test");
+        hope::threading::journal_options options;
+        options.directory = directory.c_str();
+        options.roll_size = 4096;
+        options.index_spacing = 2;
+        options.background = false;
+
+        constexpr uint64_t k_count = 10;
+        std::size_t end = hope::threading::detail::journal::k_header_size;
+        {
+            hope::threading::journal_writer writer;
+            assert(writer.open(options));
+            for (uint64_t i = 0; i < k_count; ++i) {
+                append_message(writer, i);
+                end += hope::threading::detail::journal::frame_size(message_size(i));
+            }
+        }
+        {
+            const auto path = std::filesystem::path(directory) / "journal.00000000.journal";
+            std::FILE* file = std::fopen(path.string().c_str(), "r+b");
+            assert(file);
+            // words that look like the size of a small frame
+            uint32_t garbage[64];
+            for (auto& word : garbage) {
+                word = 8;
+            }
+            std::fseek(file, static_cast<long>(end + sizeof(uint32_t)), SEEK_SET);
+            std::fwrite(garbage, 1, sizeof(garbage), file);
+            std::fclose(file);
+        }
+
+        hope::threading::journal_writer writer;
+        assert(writer.open(options));
+        assert(writer.sequence() == k_count);
+        // shorter than the lost payload
+        append_message(writer, k_count);
+
+        hope::threading::journal_reader reader;
+        assert(reader.open(options));
+        for (uint64_t i = 0; i <= k_count; ++i) {
+            assert(read_message(reader, i));
+        }
+        assert(!reader.try_read([](const uint8_t*, std::size_t) { assert(false); }));
+        assert(!reader.seek(k_count + 1));
+        append_message(writer, k_count + 1);
+        assert(read_message(reader, k_count + 1));
+        writer.close();
+        reader.close();
+        std::filesystem::remove_all(directory);
+    }
+
+    // a tailing reader follows the writer, the next files are prepared and the pages synced in the background
+    {
+        const auto directory = prepare_directory("hope_journal_tail_test");
+        hope::threading::journal_options options;
+        options.directory = directory.c_str();
+        options.roll_size = 64 * 1024;
+        options.flush_interval = std::chrono::milliseconds(1);
+
+        constexpr uint64_t k_count = 50000;
+        hope::threading::journal_writer writer;
+        assert(writer.open(options));
+
+        std::thread tail([&] {
+            hope::threading::journal_reader reader;
+            while (!reader.open(options)) {
+                std::this_thread::yield();
+            }
+            for (uint64_t i = 0; i < k_count; ++i) {
+                while (!read_message(reader, i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        for (uint64_t i = 0; i < k_count; ++i) {
+            append_message(writer, i);
+        }
+        tail.join();
+        assert(writer.cycle() > 10);
+        writer.close();
+        std::filesystem::remove_all(directory);
+    }
+}
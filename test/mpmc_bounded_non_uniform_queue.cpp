@@ -0,0 +1,159 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/mpmc_bounded_non_uniform_queue.h"
+
+namespace {
+
+    // [producer][sequence][fill...], the fill is derived from the sequence
+    struct record_prefix final {
+        uint32_t producer;
+        uint32_t sequence;
+    };
+
+    std::size_t record_size(uint32_t sequence) {
+        return sizeof(record_prefix) + sequence % 61;
+    }
+
+    template<typename TQueue>
+    void publish(TQueue& q, uint32_t producer, uint32_t sequence) {
+        const auto size = record_size(sequence);
+        q.seirialize([&](uint8_t* p) {
+            const record_prefix prefix{ producer, sequence };
+            std::memcpy(p, &prefix, sizeof(prefix));
+            for (std::size_t i = sizeof(prefix); i < size; ++i) {
+                p[i] = (uint8_t)(sequence + i);
+            }
+        }, size);
+    }
+
+    record_prefix check_record(const uint8_t* data, std::size_t size) {
+        record_prefix prefix;
+        assert(size >= sizeof(prefix));
+        std::memcpy(&prefix, data, sizeof(prefix));
+        assert(size == record_size(prefix.sequence));
+        for (std::size_t i = sizeof(prefix); i < size; ++i) {
+            assert(data[i] == (uint8_t)(prefix.sequence + i));
+        }
+        return prefix;
+    }
+
+} // namespace
+
+void run_mpmc_bounded_non_uniform_queue_tests()
+{
+    // single thread, the ring wraps many times, padding records are skipped silently
+    {
+        using queue_t = hope::threading::mpmc_bounded_non_uniform_queue<512>;
+        queue_t q;
+        auto a = q.create_consumer();
+        auto b = q.create_consumer();
+
+        auto noop = [](uint8_t*, std::size_t) { assert(false); };
+        assert(!a.try_deserialize(noop));
+
+        for (uint32_t i = 0; i < 1000; ++i) {
+            publish(q, 0, i);
+            if (i % 2 == 0) {
+                publish(q, 1, i);
+            }
+
+            uint32_t expected_producer = 0;
+            auto reader = [&](uint8_t* data, std::size_t size) {
+                const auto prefix = check_record(data, size);
+                assert(prefix.producer == expected_producer && prefix.sequence == i);
+            };
+            assert(a.try_deserialize(reader));
+            assert(b.try_deserialize(reader));
+            if (i % 2 == 0) {
+                expected_producer = 1;
+                assert(a.try_deserialize(reader));
+                assert(b.try_deserialize(reader));
+            }
+            assert(!a.try_deserialize(noop));
+            assert(!b.try_deserialize(noop));
+        }
+
+        auto full = [](uint8_t*, std::size_t size) { assert(size == queue_t::max_size); };
+        q.seirialize([](uint8_t* p) { std::memset(p, 0xAB, queue_t::max_size); }, queue_t::max_size);
+        assert(a.try_deserialize(full));
+    }
+
+    // a lapped consumer skips to the latest reservation and never hands out an overwritten record
+    {
+        using queue_t = hope::threading::mpmc_bounded_non_uniform_queue<512>;
+        queue_t q;
+        auto lapped = q.create_consumer();
+        for (uint32_t i = 0; i < 100; ++i) {
+            publish(q, 0, i);
+        }
+
+        auto noop = [](uint8_t*, std::size_t) { assert(false); };
+        assert(!lapped.try_deserialize(noop));
+        assert(!lapped.try_deserialize(noop));
+
+        publish(q, 2, 100);
+        auto reader = [](uint8_t* data, std::size_t size) {
+            const auto prefix = check_record(data, size);
+            assert(prefix.producer == 2 && prefix.sequence == 100);
+        };
+        assert(lapped.try_deserialize(reader));
+        assert(!lapped.try_deserialize(noop));
+    }
+
+    // producers commit out of order, every consumer sees all the records of a producer in its order;
+    // the ring is big enough to never lap the consumers
+    {
+        constexpr std::size_t k_buffer_size = 1 << 20;
+        constexpr uint32_t k_producers = 4;
+        constexpr uint32_t k_items = 3000;
+        using queue_t = hope::threading::mpmc_bounded_non_uniform_queue<k_buffer_size>;
+
+        auto q = std::make_unique<queue_t>();
+        auto consume = [&q] {
+            auto c = q->create_consumer();
+            return [c, &q]() mutable {
+                std::vector<uint32_t> expected(k_producers, 0);
+                uint32_t received = 0;
+                auto reader = [&](uint8_t* data, std::size_t size) {
+                    const auto prefix = check_record(data, size);
+                    assert(prefix.producer < k_producers);
+                    assert(prefix.sequence == expected[prefix.producer]);
+                    ++expected[prefix.producer];
+                    ++received;
+                };
+                while (received < k_producers * k_items) {
+                    if (!c.try_deserialize(reader)) {
+                        std::this_thread::yield();
+                    }
+                }
+            };
+        };
+
+        std::vector<std::thread> threads;
+        threads.emplace_back(consume());
+        threads.emplace_back(consume());
+        for (uint32_t p = 0; p < k_producers; ++p) {
+            threads.emplace_back([&q, p] {
+                for (uint32_t i = 0; i < k_items; ++i) {
+                    publish(*q, p, i);
+                }
+            });
+        }
+        for (auto&& t : threads) {
+            t.join();
+        }
+    }
+}
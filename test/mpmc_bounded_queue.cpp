@@ -0,0 +1,252 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <atomic>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/mpmc_bounded_queue.h"
+
+namespace {
+
+    // not default constructible, counts live instances
+    struct tracked final {
+        explicit tracked(int in_value, std::atomic<int>& in_alive)
+            : value(in_value), alive(&in_alive) {
+            alive->fetch_add(1);
+        }
+
+        tracked(tracked&& rhs) noexcept
+            : value(rhs.value), alive(rhs.alive) {
+            alive->fetch_add(1);
+        }
+
+        tracked& operator=(tracked&& rhs) noexcept {
+            value = rhs.value;
+            return *this;
+        }
+
+        ~tracked() {
+            alive->fetch_sub(1);
+        }
+
+        int value;
+        std::atomic<int>* alive;
+    };
+
+    // bulk and single operations mixed from several threads, every value must be seen exactly once
+    template<typename TQueue>
+    void run_mixed_stress(std::size_t size) {
+        constexpr int k_producers = 4;
+        constexpr int k_consumers = 4;
+        constexpr int k_items_per_producer = 20000;
+        constexpr int k_batch = 7;
+
+        TQueue q(size);
+        std::vector<std::atomic<int>> seen(k_producers * k_items_per_producer);
+        std::atomic<int> consumed{ 0 };
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < k_producers; ++p) {
+            threads.emplace_back([&q, p] {
+                std::array<int, k_batch> batch{};
+                int next = 0;
+                while (next < k_items_per_producer) {
+                    if (p % 2 == 0) {
+                        int count = 0;
+                        for (; count < k_batch && next + count < k_items_per_producer; ++count) {
+                            batch[count] = p * k_items_per_producer + next + count;
+                        }
+                        const auto pushed = q.try_enqueue_bulk(batch.begin(), batch.begin() + count);
+                        next += (int)pushed;
+                        if (pushed == 0) {
+                            std::this_thread::yield();
+                        }
+                    } else if (q.try_enqueue(p * k_items_per_producer + next)) {
+                        ++next;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (int c = 0; c < k_consumers; ++c) {
+            threads.emplace_back([&, c] {
+                std::array<int, k_batch> batch{};
+                while (consumed.load(std::memory_order_relaxed) < k_producers * k_items_per_producer) {
+                    std::size_t popped = 0;
+                    if (c % 2 == 0) {
+                        popped = q.try_dequeue_bulk(batch.begin(), batch.size());
+                    } else {
+                        popped = q.try_dequeue(batch[0]) ? 1 : 0;
+                    }
+                    for (std::size_t i = 0; i < popped; ++i) {
+                        seen[batch[i]].fetch_add(1, std::memory_order_relaxed);
+                    }
+                    if (popped == 0) {
+                        std::this_thread::yield();
+                    }
+                    consumed.fetch_add((int)popped, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        for (auto&& t : threads) {
+            t.join();
+        }
+
+        for (auto&& s : seen) {
+            assert(s.load() == 1);
+        }
+    }
+
+} // namespace
+
+void run_mpmc_bounded_queue_tests()
+{
+    using queue_t = hope::threading::mpmc_bounded_queue<int>;
+
+    {
+        queue_t q(4);
+        int v = -1;
+        assert(!q.try_dequeue(v));
+        for (int i = 0; i < 4; ++i) {
+            assert(q.try_enqueue(i));
+        }
+        assert(!q.try_enqueue(4));
+        for (int i = 0; i < 4; ++i) {
+            assert(q.try_dequeue(v) && v == i);
+        }
+        assert(!q.try_dequeue(v));
+    }
+
+    // bulk operations, partial success near the capacity
+    {
+        queue_t q(8);
+        const std::array<int, 5> first{ 0, 1, 2, 3, 4 };
+        const std::array<int, 5> second{ 5, 6, 7, 8, 9 };
+        assert(q.try_enqueue_bulk(first.begin(), first.end()) == 5);
+        assert(q.try_enqueue_bulk(second.begin(), second.end()) == 3);
+        assert(q.try_enqueue_bulk(second.begin(), second.end()) == 0);
+
+        std::array<int, 8> out{};
+        assert(q.try_dequeue_bulk(out.begin(), 2) == 2);
+        assert(out[0] == 0 && out[1] == 1);
+        assert(q.try_dequeue_bulk(out.begin(), out.size()) == 6);
+        for (int i = 0; i < 6; ++i) {
+            assert(out[i] == i + 2);
+        }
+        assert(q.try_dequeue_bulk(out.begin(), out.size()) == 0);
+
+        // wrap around the ring
+        assert(q.try_enqueue_bulk(second.begin(), second.end()) == 5);
+        assert(q.try_enqueue(10));
+        std::vector<int> drained;
+        assert(q.try_dequeue_bulk(std::back_inserter(drained), 16) == 6);
+        assert((drained == std::vector<int>{ 5, 6, 7, 8, 9, 10 }));
+    }
+
+    // small rings are not shuffled, big ones are
+    for (std::size_t size : { 2u, 4u, 16u, 1024u }) {
+        hope::threading::mpmc_bounded_queue<int, hope::threading::mpmc_layout::packed> q(size);
+        assert(q.storage_size() < queue_t(size).storage_size());
+        for (int rep = 0; rep < 3; ++rep) {
+            for (int i = 0; i < (int)size; ++i) {
+                assert(q.try_enqueue(i));
+            }
+            assert(!q.try_enqueue(-1));
+            for (int i = 0; i < (int)size; ++i) {
+                int v = -1;
+                assert(q.try_dequeue(v) && v == i);
+            }
+        }
+    }
+
+    // in-place construction, items are destroyed as soon as they are consumed
+    {
+        std::atomic<int> alive{ 0 };
+        {
+            hope::threading::mpmc_bounded_queue<tracked> q(8);
+            assert(alive.load() == 0);
+            for (int i = 0; i < 6; ++i) {
+                assert(q.try_emplace(i, alive));
+            }
+            assert(alive.load() == 6);
+            int consumed = -1;
+            assert(q.try_consume([&consumed](tracked&& t) { consumed = t.value; }));
+            assert(consumed == 0);
+            assert(alive.load() == 5);
+            assert(q.try_consume([&consumed](const tracked& t) { consumed = t.value; }));
+            assert(consumed == 1);
+            assert(alive.load() == 4);
+        }
+        // the rest is destroyed with the queue
+        assert(alive.load() == 0);
+    }
+
+    {
+        hope::threading::mpmc_bounded_queue<std::unique_ptr<std::string>> q(4);
+        assert(q.try_emplace(std::make_unique<std::string>(256, 'x')));
+        assert(q.try_enqueue(std::make_unique<std::string>("moved")));
+        std::unique_ptr<std::string> out;
+        assert(q.try_dequeue(out) && out->size() == 256);
+        assert(q.try_consume([](std::unique_ptr<std::string> s) { assert(*s == "moved"); }));
+        assert(!q.try_consume([](std::unique_ptr<std::string>&&) { assert(false); }));
+    }
+
+    // a throwing constructor gives the slot away, the consumers skip it and the ring keeps wrapping
+    {
+        struct picky final {
+            explicit picky(int in_value) : value(in_value) {
+                if (in_value < 0)
+                    throw std::invalid_argument("negative");
+            }
+            int value;
+        };
+
+        hope::threading::mpmc_bounded_queue<picky, hope::threading::mpmc_layout::packed> q(8);
+        for (int lap = 0; lap < 8; ++lap) {
+            bool thrown = false;
+            assert(q.try_emplace(lap));
+            try {
+                (void)q.try_emplace(-1);
+            } catch (const std::invalid_argument&) {
+                thrown = true;
+            }
+            assert(thrown);
+            assert(q.try_emplace(lap + 100));
+
+            const std::array<int, 3> bulk{ lap + 200, -2, lap + 300 };
+            thrown = false;
+            try {
+                (void)q.try_enqueue_bulk(bulk.begin(), bulk.end());
+            } catch (const std::invalid_argument&) {
+                thrown = true;
+            }
+            assert(thrown);
+
+            int consumed = -1;
+            assert(q.try_consume([&consumed](picky&& p) { consumed = p.value; }) && consumed == lap);
+            assert(q.try_consume([&consumed](picky&& p) { consumed = p.value; }) && consumed == lap + 100);
+            // the bulk item before the throwing one is there, the ones from it on are skipped
+            std::vector<picky> out;
+            assert(q.try_dequeue_bulk(std::back_inserter(out), 4) == 1 && out[0].value == lap + 200);
+            assert(!q.try_consume([](picky&&) { assert(false); }));
+        }
+    }
+
+    run_mixed_stress<queue_t>(256);
+    run_mixed_stress<hope::threading::mpmc_bounded_queue<int, hope::threading::mpmc_layout::packed>>(256);
+}
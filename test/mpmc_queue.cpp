@@ -0,0 +1,117 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/mpmc_queue.h"
+
+namespace {
+
+    std::atomic<int> g_alive{ 0 };
+
+    struct tracked final {
+        explicit tracked(int in_value) : value(in_value) { g_alive.fetch_add(1); }
+        tracked(tracked&& other) noexcept : value(other.value) { g_alive.fetch_add(1); }
+        tracked& operator=(tracked&& other) noexcept { value = other.value; return *this; }
+        ~tracked() { g_alive.fetch_sub(1); }
+
+        int value;
+    };
+
+} // namespace
+
+void run_mpmc_queue_tests()
+{
+    // fifo over many segments, drained segments are reused
+    {
+        hope::threading::mpmc_queue<std::unique_ptr<std::string>, 4> q;
+        std::unique_ptr<std::string> v;
+        assert(!q.try_dequeue(v));
+        for (int rep = 0; rep < 10; ++rep) {
+            for (int i = 0; i < 37; ++i) {
+                q.enqueue(std::make_unique<std::string>(std::to_string(i)));
+            }
+            assert(q.size() == 37);
+            for (int i = 0; i < 37; ++i) {
+                assert(q.try_dequeue(v) && *v == std::to_string(i));
+            }
+            assert(!q.try_dequeue(v));
+        }
+    }
+
+    // items left in the queue are destroyed with it
+    {
+        {
+            hope::threading::mpmc_queue<tracked, 8> q;
+            for (int i = 0; i < 30; ++i) {
+                q.emplace(i);
+            }
+            assert(q.try_consume([](tracked&& t) { assert(t.value == 0); }));
+            assert(g_alive.load() == 29);
+        }
+        assert(g_alive.load() == 0);
+    }
+
+    // producers never fail, consumers see every item once and in the order of every producer
+    {
+        constexpr int k_producers = 3;
+        constexpr int k_consumers = 3;
+        constexpr int k_items = 50000;
+
+        hope::threading::mpmc_queue<int, 16> q;
+        std::vector<std::vector<int>> received(k_consumers);
+        std::atomic<int> consumed{ 0 };
+        std::vector<std::thread> ts;
+
+        for (int p = 0; p < k_producers; ++p) {
+            ts.emplace_back([&q, p] {
+                for (int i = 0; i < k_items; ++i) {
+                    q.enqueue(p * k_items + i);
+                    if (i % 128 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int c = 0; c < k_consumers; ++c) {
+            ts.emplace_back([&, c] {
+                std::vector<int> last(k_producers, -1);
+                int v;
+                while (consumed.load(std::memory_order_relaxed) < k_producers * k_items) {
+                    if (q.try_dequeue(v)) {
+                        const int p = v / k_items;
+                        assert(v % k_items > last[p]);
+                        last[p] = v % k_items;
+                        received[c].push_back(v);
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto&& t : ts) {
+            t.join();
+        }
+
+        std::vector<char> seen(k_producers * k_items, 0);
+        for (auto&& part : received) {
+            for (auto v : part) {
+                assert(seen[v] == 0);
+                seen[v] = 1;
+            }
+        }
+        int v;
+        assert(!q.try_dequeue(v));
+    }
+}
@@ -0,0 +1,83 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/mpsc_queue.h"
+
+namespace {
+
+    template<hope::threading::alloc_policy policy>
+    void run_consume_all_tests() {
+        {
+            hope::threading::mpsc_queue<std::string, policy> q;
+            assert(q.consume_all([](std::string&&) { assert(false); }) == 0);
+
+            for (int i = 0; i < 10; ++i) {
+                q.enqueue(std::to_string(i));
+            }
+
+            std::string v;
+            assert(q.try_dequeue(v) && v == "0");
+
+            std::vector<std::string> drained;
+            assert(q.consume_all([&drained](std::string&& s) { drained.push_back(std::move(s)); }) == 9);
+            assert(drained.size() == 9);
+            for (int i = 0; i < 9; ++i) {
+                assert(drained[i] == std::to_string(i + 1));
+            }
+            assert(!q.try_dequeue(v));
+
+            q.enqueue(std::string("after"));
+            assert(q.try_dequeue(v) && v == "after");
+        }
+
+        {
+            constexpr int k_producers = 4;
+            constexpr int k_items = 20000;
+
+            hope::threading::mpsc_queue<int, policy> q;
+            std::vector<std::thread> producers;
+            for (int p = 0; p < k_producers; ++p) {
+                producers.emplace_back([&q, p] {
+                    for (int i = 0; i < k_items; ++i) {
+                        q.enqueue(p * k_items + i);
+                    }
+                });
+            }
+
+            std::vector<int> expected(k_producers, 0);
+            int received = 0;
+            while (received < k_producers * k_items) {
+                const auto count = q.consume_all([&](int&& v) {
+                    const int p = v / k_items;
+                    assert(v % k_items == expected[p]);
+                    ++expected[p];
+                });
+                received += (int)count;
+                if (count == 0) {
+                    std::this_thread::yield();
+                }
+            }
+
+            for (auto&& t : producers) {
+                t.join();
+            }
+        }
+    }
+
+} // namespace
+
+void run_mpsc_queue_tests()
+{
+    run_consume_all_tests<hope::threading::alloc_policy::new_only>();
+    run_consume_all_tests<hope::threading::alloc_policy::buffered>();
+}
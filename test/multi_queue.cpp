@@ -0,0 +1,93 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/multi_queue.h"
+
+void run_multi_queue_tests()
+{
+    // with two heaps both of them are compared on every pop, so a single thread sees the exact order
+    {
+        hope::threading::multi_queue<int, std::string> q(1, 2);
+        assert(q.heaps_count() == 2);
+        int priority;
+        std::string value;
+        assert(!q.try_pop(priority, value));
+
+        for (int i = 0; i < 1000; ++i) {
+            const int p = (i * 7919) % 1000;
+            q.push(p, std::to_string(p));
+        }
+        assert(q.size() == 1000);
+        for (int expected = 999; expected >= 0; --expected) {
+            assert(q.try_pop(priority, value));
+            assert(priority == expected && value == std::to_string(expected));
+        }
+        assert(!q.try_pop(value));
+        assert(q.size() == 0);
+    }
+
+    // min queue
+    {
+        hope::threading::multi_queue<int, int, std::greater<int>> q(1, 2);
+        q.push(3, 30);
+        q.push(1, 10);
+        q.push(2, 20);
+        int value;
+        assert(q.try_pop(value) && value == 10);
+        assert(q.try_pop(value) && value == 20);
+        assert(q.try_pop(value) && value == 30);
+        assert(!q.try_pop(value));
+    }
+
+    // nothing is lost or duplicated
+    {
+        constexpr int k_threads = 4;
+        constexpr int k_items = 20000;
+        hope::threading::multi_queue<int, int> q(k_threads);
+
+        std::vector<std::atomic<int>> seen(k_threads * k_items);
+        std::atomic<int> popped{ 0 };
+        std::vector<std::thread> ts;
+        for (int t = 0; t < k_threads; ++t) {
+            ts.emplace_back([&, t] {
+                int value;
+                for (int i = 0; i < k_items; ++i) {
+                    const int v = t * k_items + i;
+                    q.push(v % 977, v);
+                    if (i % 2 == 0 && q.try_pop(value)) {
+                        seen[value].fetch_add(1, std::memory_order_relaxed);
+                        popped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    if (i % 256 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto&& t : ts) {
+            t.join();
+        }
+
+        int value;
+        while (q.try_pop(value)) {
+            seen[value].fetch_add(1, std::memory_order_relaxed);
+            popped.fetch_add(1, std::memory_order_relaxed);
+        }
+        assert(popped.load() == k_threads * k_items);
+        for (auto&& s : seen) {
+            assert(s.load() == 1);
+        }
+    }
+}
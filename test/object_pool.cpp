@@ -0,0 +1,96 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "hope_thread/core/object_pool.h"
+
+namespace {
+
+    struct alignas(32) aligned_payload final {
+        explicit aligned_payload(int in_value) : value(in_value) { }
+        int value;
+    };
+
+} // namespace
+
+void run_object_pool_tests()
+{
+    // blocks are reused, the memory grows by whole chunks
+    {
+        hope::threading::object_pool<aligned_payload> pool;
+        std::vector<aligned_payload*> objects;
+        std::unordered_set<aligned_payload*> unique;
+        for (int i = 0; i < 1000; ++i) {
+            auto* p = pool.create(i);
+            assert(reinterpret_cast<uintptr_t>(p) % alignof(aligned_payload) == 0);
+            assert(unique.insert(p).second);
+            objects.push_back(p);
+        }
+        const auto chunks = pool.chunks_count();
+        assert(chunks * hope::threading::block_pool::magazine_capacity >= 1000);
+
+        for (int i = 0; i < 1000; ++i) {
+            assert(objects[i]->value == i);
+            pool.destroy(objects[i]);
+        }
+        for (int rep = 0; rep < 10; ++rep) {
+            objects.clear();
+            for (int i = 0; i < 1000; ++i) {
+                objects.push_back(pool.create(i));
+            }
+            for (auto* p : objects) {
+                pool.destroy(p);
+            }
+        }
+        assert(pool.chunks_count() == chunks);
+    }
+
+    // objects created on one thread and destroyed on another, magazines flow through the depot
+    {
+        constexpr int k_items = 100000;
+        hope::threading::object_pool<std::string> pool;
+        std::vector<std::atomic<std::string*>> slots(256);
+        for (auto&& s : slots) {
+            s.store(nullptr);
+        }
+
+        std::thread producer([&] {
+            for (int i = 0; i < k_items; ++i) {
+                auto&& slot = slots[i % slots.size()];
+                while (slot.load(std::memory_order_acquire) != nullptr) {
+                    std::this_thread::yield();
+                }
+                slot.store(pool.create(std::to_string(i)), std::memory_order_release);
+            }
+        });
+        std::thread consumer([&] {
+            for (int i = 0; i < k_items; ++i) {
+                auto&& slot = slots[i % slots.size()];
+                std::string* s;
+                while ((s = slot.load(std::memory_order_acquire)) == nullptr) {
+                    std::this_thread::yield();
+                }
+                assert(*s == std::to_string(i));
+                slot.store(nullptr, std::memory_order_release);
+                pool.destroy(s);
+            }
+        });
+        producer.join();
+        consumer.join();
+
+        // steady state does not allocate: far less chunks than objects
+        assert(pool.chunks_count() * hope::threading::block_pool::magazine_capacity < k_items / 10);
+    }
+}
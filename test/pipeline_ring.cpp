@@ -0,0 +1,169 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/pipeline_ring.h"
+
+namespace {
+
+    struct order final {
+        uint64_t id{ 0 };
+        uint64_t parsed{ 0 };
+        uint64_t journaled{ 0 };
+        uint64_t replicated{ 0 };
+        uint64_t committed{ 0 };
+    };
+
+    // decode -> { journal, replicate } -> commit, every stage checks that its upstream has already
+    // modified the entry in place
+    template<typename TWait>
+    void run_diamond_test(uint64_t k_items) {
+        using ring_t = hope::threading::pipeline_ring<order, 64, TWait>;
+
+        typename ring_t::builder b;
+        const auto decode = b.add_stage();
+        const auto journal = b.add_stage({ decode });
+        const auto replicate = b.add_stage({ decode });
+        const auto commit = b.add_stage({ journal, replicate });
+        auto ring = b.build();
+
+        std::vector<std::thread> ts;
+        ts.emplace_back([&] {
+            uint64_t expected = 0;
+            while (expected < k_items) {
+                ring->get_stage(decode).wait_and_process([&](order& o) {
+                    assert(o.id == expected);
+                    o.parsed = o.id + 1;
+                    ++expected;
+                }, 16);
+            }
+        });
+        ts.emplace_back([&] {
+            uint64_t expected = 0;
+            while (expected < k_items) {
+                ring->get_stage(journal).wait_and_process([&](order& o) {
+                    assert(o.id == expected && o.parsed == o.id + 1);
+                    o.journaled = 1;
+                    ++expected;
+                }, 16);
+            }
+        });
+        ts.emplace_back([&] {
+            uint64_t expected = 0;
+            while (expected < k_items) {
+                ring->get_stage(replicate).wait_and_process([&](order& o) {
+                    assert(o.id == expected && o.parsed == o.id + 1);
+                    o.replicated = 1;
+                    ++expected;
+                }, 16);
+            }
+        });
+        uint64_t committed = 0;
+        ts.emplace_back([&] {
+            while (committed < k_items) {
+                ring->get_stage(commit).wait_and_process([&](order& o) {
+                    assert(o.id == committed && o.journaled == 1 && o.replicated == 1);
+                    o.committed = 1;
+                    ++committed;
+                }, 16);
+            }
+        });
+
+        for (uint64_t i = 0; i < k_items; ++i) {
+            ring->publish([i](order& o) { o = order{ i }; });
+        }
+        for (auto&& t : ts) {
+            t.join();
+        }
+        assert(committed == k_items);
+        assert(ring->get_stage(commit).sequence() == k_items);
+    }
+
+} // namespace
+
+void run_pipeline_ring_tests()
+{
+    // linear chain, the producer gates on the last stage only
+    {
+        using ring_t = hope::threading::pipeline_ring<int, 4>;
+        ring_t::builder b;
+        const auto parse = b.add_stage();
+        const auto enrich = b.add_stage({ parse });
+        const auto persist = b.add_stage({ enrich });
+        auto ring = b.build();
+        assert(ring->stages_count() == 3);
+
+        for (int i = 0; i < 4; ++i) {
+            assert(ring->try_publish([i](int& v) { v = i; }));
+        }
+        assert(!ring->try_publish([](int& v) { v = -1; }));
+
+        // a stage does not run ahead of its upstream
+        assert(ring->get_stage(enrich).process([](int&) { assert(false); }) == 0);
+        assert(ring->get_stage(parse).process([](int& v) { v *= 10; }, 2) == 2);
+        assert(ring->get_stage(enrich).process([](int& v) { v += 1; }) == 2);
+        assert(!ring->try_publish([](int& v) { v = -1; }));
+
+        // the entries are modified in place by every stage
+        std::vector<int> persisted;
+        assert(ring->get_stage(persist).process([&](int& v) { persisted.push_back(v); }) == 2);
+        assert((persisted == std::vector<int>{ 1, 11 }));
+        assert(ring->try_publish([](int& v) { v = 4; }));
+        assert(ring->try_publish([](int& v) { v = 5; }));
+        assert(!ring->try_publish([](int& v) { v = -1; }));
+
+        assert(ring->get_stage(parse).process([](int& v) { v *= 10; }) == 4);
+        assert(ring->get_stage(enrich).process([](int& v) { v += 1; }) == 4);
+        assert(ring->get_stage(persist).process([&](int& v) { persisted.push_back(v); }) == 4);
+        assert((persisted == std::vector<int>{ 1, 11, 21, 31, 41, 51 }));
+        assert(ring->get_stage(persist).sequence() == 6);
+    }
+
+    // both branches of a diamond gate the producer through the joining stage
+    {
+        using ring_t = hope::threading::pipeline_ring<int, 2>;
+        ring_t::builder b;
+        const auto decode = b.add_stage();
+        const auto left = b.add_stage({ decode });
+        const auto right = b.add_stage({ decode });
+        const auto join = b.add_stage({ left, right });
+        auto ring = b.build();
+
+        assert(ring->try_publish([](int& v) { v = 1; }));
+        assert(ring->get_stage(decode).process([](int&) { }) == 1);
+        assert(ring->get_stage(left).process([](int&) { }) == 1);
+        assert(ring->get_stage(join).process([](int&) { assert(false); }) == 0);
+        assert(ring->get_stage(right).process([](int&) { }) == 1);
+        assert(ring->get_stage(join).process([](int&) { }) == 1);
+    }
+
+    // two independent terminal stages, both of them gate the producer
+    {
+        using ring_t = hope::threading::pipeline_ring<int, 2>;
+        ring_t::builder b;
+        const auto fast = b.add_stage();
+        const auto slow = b.add_stage();
+        auto ring = b.build();
+
+        assert(ring->try_publish([](int& v) { v = 1; }));
+        assert(ring->try_publish([](int& v) { v = 2; }));
+        assert(ring->get_stage(fast).process([](int&) { }) == 2);
+        assert(!ring->try_publish([](int& v) { v = 3; }));
+        assert(ring->get_stage(slow).process([](int&) { }, 1) == 1);
+        assert(ring->try_publish([](int& v) { v = 3; }));
+    }
+
+    // spinning threads might share a single core, keep the busy spin run short
+    run_diamond_test<hope::threading::busy_spin_wait>(2000);
+    run_diamond_test<hope::threading::yielding_wait>(100000);
+    run_diamond_test<hope::threading::parking_wait>(100000);
+}
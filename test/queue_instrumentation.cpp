@@ -0,0 +1,206 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hope_thread/core/histogram.h"
+#include "hope_thread/core/instrumentation.h"
+#include "hope_thread/containers/queue/mpmc_bounded_queue.h"
+#include "hope_thread/containers/queue/mpsc_bounded_queue.h"
+#include "hope_thread/containers/queue/spsc_bounded_queue.h"
+
+namespace {
+
+    using hope::threading::mpmc_layout;
+    using hope::threading::queue_instrumentation;
+    using hope::threading::null_queue_instrumentation;
+
+    static_assert(std::is_empty_v<null_queue_instrumentation>);
+    static_assert(sizeof(hope::threading::mpmc_bounded_queue<int, mpmc_layout::packed>)
+        == sizeof(hope::threading::mpmc_bounded_queue<int, mpmc_layout::packed, null_queue_instrumentation>));
+
+    // percentiles are upper bounds of the buckets, the bucket is at most 1/16 of the value wide
+    bool close_to(uint64_t value, uint64_t expected) {
+        return value >= expected && value <= expected + expected / 16 + 1;
+    }
+
+} // namespace
+
+void run_queue_instrumentation_tests()
+{
+    // log-linear buckets
+    {
+        hope::threading::histogram h;
+        for (uint64_t v = 1; v <= 100000; ++v) {
+            h.record(v);
+        }
+        assert(h.count() == 100000);
+        assert(h.min() == 1);
+        assert(h.max() == 100000);
+        assert(close_to(h.percentile(50), 50000));
+        assert(close_to(h.percentile(99), 99000));
+        assert(h.percentile(100) == 100000);
+
+        hope::threading::histogram small;
+        for (uint64_t v = 0; v < 16; ++v) {
+            small.record(v);
+        }
+        assert(small.percentile(50) == 7);
+
+        auto merged = h;
+        merged.merge(small);
+        assert(merged.count() == 100016);
+        merged.subtract(h);
+        assert(merged.count() == 16);
+    }
+
+    // per thread recording, snapshots are taken while the writers are running
+    {
+        hope::threading::concurrent_histogram h;
+        constexpr std::size_t threads = 4;
+        constexpr uint64_t per_thread = 200000;
+        std::atomic<bool> done{ false };
+
+        std::thread scraper([&] {
+            uint64_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                const auto count = h.snapshot().count();
+                assert(count >= last);
+                last = count;
+            }
+        });
+
+        std::vector<std::thread> writers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            writers.emplace_back([&h, t] {
+                for (uint64_t v = 0; v < per_thread; ++v) {
+                    h.record(v % 1000 + t);
+                }
+            });
+        }
+        for (auto&& w : writers) {
+            w.join();
+        }
+        done.store(true, std::memory_order_release);
+        scraper.join();
+
+        const auto snapshot = h.snapshot();
+        assert(snapshot.count() == threads * per_thread);
+        assert(snapshot.min() == 0);
+        assert(snapshot.max() == 999 + threads - 1);
+    }
+
+    // failures and residency of mpmc_bounded_queue
+    {
+        hope::threading::mpmc_bounded_queue<int, mpmc_layout::padded, queue_instrumentation> q(4);
+        for (int i = 0; i < 4; ++i) {
+            assert(q.try_enqueue(i));
+        }
+        assert(!q.try_enqueue(4));
+
+        std::vector<int> out;
+        assert(q.try_dequeue_bulk(std::back_inserter(out), 3) == 3);
+        int v;
+        assert(q.try_dequeue(v) && v == 3);
+        assert(!q.try_dequeue(v));
+
+        const int bulk[] = { 5, 6 };
+        assert(q.try_enqueue_bulk(std::begin(bulk), std::end(bulk)) == 2);
+
+        const auto stats = q.stats();
+        assert(stats.enqueued == 6);
+        assert(stats.dequeued == 4);
+        assert(stats.full_failures == 1);
+        assert(stats.empty_failures == 1);
+        assert(stats.cas_retries == 0);
+        assert(stats.residency.count() == 4);
+    }
+
+    // contended claims are counted as retries, every item is accounted exactly once
+    {
+        hope::threading::mpmc_bounded_queue<int, mpmc_layout::packed, queue_instrumentation> q(1024);
+        constexpr int per_producer = 50000;
+        std::atomic<int> consumed{ 0 };
+        std::vector<std::thread> ts;
+        for (int p = 0; p < 2; ++p) {
+            ts.emplace_back([&] {
+                for (int i = 0; i < per_producer; ++i) {
+                    while (!q.try_enqueue(i)) { }
+                }
+            });
+            ts.emplace_back([&] {
+                int item;
+                while (consumed.load(std::memory_order_relaxed) < 2 * per_producer) {
+                    if (q.try_dequeue(item)) {
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto&& t : ts) {
+            t.join();
+        }
+
+        const auto stats = q.stats();
+        assert(stats.enqueued == 2 * per_producer);
+        assert(stats.dequeued == 2 * per_producer);
+        assert(stats.residency.count() == 2 * per_producer);
+    }
+
+    // spans of spsc_bounded_queue are stamped at commit
+    {
+        hope::threading::spsc_bounded_queue<int, queue_instrumentation> q(8);
+        auto span = q.write_span();
+        assert(span.size() == 8);
+        for (int i = 0; i < 3; ++i) {
+            span[i] = i;
+        }
+        q.commit(3);
+        assert(q.try_enqueue(3));
+
+        auto ready = q.read_span();
+        assert(ready.size() == 4);
+        q.release(4);
+        int v;
+        assert(!q.try_dequeue(v));
+
+        const auto stats = q.stats();
+        assert(stats.enqueued == 4);
+        assert(stats.dequeued == 4);
+        assert(stats.empty_failures == 1);
+        assert(stats.residency.count() == 4);
+    }
+
+    // mpsc_bounded_queue
+    {
+        hope::threading::mpsc_bounded_queue<int, 2, queue_instrumentation> q;
+        assert(q.try_enqueue(1));
+        assert(q.try_enqueue(2));
+        assert(!q.try_enqueue(3));
+        int v;
+        assert(q.try_dequeue(v) && v == 1);
+        assert(q.try_dequeue(v) && v == 2);
+        assert(!q.try_dequeue(v));
+
+        const auto stats = q.stats();
+        assert(stats.enqueued == 2 && stats.dequeued == 2);
+        assert(stats.full_failures == 1 && stats.empty_failures == 1);
+    }
+
+    // not instrumented queues report nothing
+    {
+        hope::threading::mpmc_bounded_queue<int, mpmc_layout::padded, null_queue_instrumentation> q(4);
+        assert(q.try_enqueue(1));
+        assert(q.stats().enqueued == 0);
+    }
+}
@@ -0,0 +1,113 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/core/epoch.h"
+#include "hope_thread/core/hazard_pointer.h"
+
+namespace {
+
+    std::atomic<int> g_alive{ 0 };
+
+    struct node final {
+        explicit node(int in_value) : value(in_value) { g_alive.fetch_add(1); }
+        ~node() { magic = 0; g_alive.fetch_sub(1); }
+
+        int value;
+        int magic{ 0x600d };
+    };
+
+    // writers keep replacing the shared node and retire the old one, readers dereference it under the guard;
+    // a node freed too early would be caught by the magic check (or by the sanitizer)
+    template<typename TDomain>
+    void run_domain_tests() {
+        {
+            TDomain domain;
+            std::atomic<node*> shared{ new node(0) };
+
+            {
+                typename TDomain::guard g(domain);
+                auto* protected_node = g.protect(shared);
+                auto* old = shared.exchange(new node(1));
+                assert(old == protected_node);
+                domain.retire(old);
+                domain.reclaim();
+                // still observed by the guard
+                assert(protected_node->magic == 0x600d && protected_node->value == 0);
+            }
+            domain.reclaim();
+            domain.reclaim();
+            domain.reclaim();
+            assert(g_alive.load() == 1);
+
+            delete shared.load();
+        }
+        assert(g_alive.load() == 0);
+
+        {
+            constexpr int k_readers = 3;
+            constexpr int k_writers = 2;
+            constexpr int k_updates = 20000;
+
+            TDomain domain;
+            std::atomic<node*> shared{ new node(0) };
+            std::atomic<bool> done{ false };
+            std::vector<std::thread> ts;
+
+            for (int r = 0; r < k_readers; ++r) {
+                ts.emplace_back([&] {
+                    while (!done.load(std::memory_order_acquire)) {
+                        for (int i = 0; i < 64; ++i) {
+                            typename TDomain::guard g(domain);
+                            auto* n = g.protect(shared);
+                            assert(n->magic == 0x600d);
+                            assert(n->value >= 0);
+                        }
+                        std::this_thread::yield();
+                    }
+                });
+            }
+            for (int w = 0; w < k_writers; ++w) {
+                ts.emplace_back([&, w] {
+                    for (int i = 0; i < k_updates; ++i) {
+                        auto* old = shared.exchange(new node(w * k_updates + i));
+                        domain.retire(old);
+                        if (i % 512 == 0) {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+            }
+
+            for (int i = k_readers; i < k_readers + k_writers; ++i) {
+                ts[i].join();
+            }
+            done.store(true, std::memory_order_release);
+            for (int i = 0; i < k_readers; ++i) {
+                ts[i].join();
+            }
+
+            // batches are reclaimed on the way, only the tail of the retired lists is left
+            assert(g_alive.load() < k_writers * k_updates / 2);
+            delete shared.load();
+        }
+        // the rest goes with the domain, including the lists of the exited threads
+        assert(g_alive.load() == 0);
+    }
+
+} // namespace
+
+void run_reclamation_tests()
+{
+    run_domain_tests<hope::threading::hazard_pointer_domain<>>();
+    run_domain_tests<hope::threading::epoch_domain>();
+}
@@ -0,0 +1,117 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include "hope_thread/containers/queue/shm_mpmc_bounded_queue.h"
+#include "hope_thread/containers/queue/spmc_bounded_message_queue.h"
+#include "hope_thread/platform/segment_header.h"
+
+namespace {
+
+    using namespace hope::threading::platform;
+
+    static_assert(layout_hash<hope::threading::spmc_bounded_message_queue<int, 64>>()
+        != layout_hash<hope::threading::spmc_bounded_message_queue<int, 128>>());
+    static_assert(layout_hash<int>() != layout_hash<unsigned>());
+
+    // zero filled, as a freshly created segment
+    struct segment_memory final {
+        explicit segment_memory(std::size_t in_size)
+            : size(in_size)
+            , data(::operator new(in_size, std::align_val_t{ 4096 })) {
+            std::memset(data, 0, size);
+        }
+
+        ~segment_memory() {
+            ::operator delete(data, std::align_val_t{ 4096 });
+        }
+
+        std::size_t size;
+        void* data;
+    };
+
+} // namespace
+
+void run_segment_header_tests()
+{
+    using queue_t = hope::threading::spmc_bounded_message_queue<int, 64>;
+    using object_t = shared_segment_object<queue_t>;
+
+    // nobody created the object - the attach times out
+    {
+        segment_memory memory(object_t::required_size());
+        object_t consumer(memory.data);
+        assert(consumer.attach(std::chrono::milliseconds(5), memory.size) == attach_result::timeout);
+        assert(consumer.get() == nullptr);
+    }
+
+    // the attach waits for the producer, then the producer restarts
+    {
+        segment_memory memory(object_t::required_size());
+        object_t consumer(memory.data);
+        std::thread producer_thread([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            object_t producer(memory.data);
+            auto* queue = producer.create();
+            queue->try_enqueue(42);
+        });
+        assert(consumer.attach(std::chrono::seconds(30), memory.size) == attach_result::ok);
+        producer_thread.join();
+        assert(consumer.epoch() == 1);
+        assert(!consumer.stale());
+
+        object_t restarted(memory.data);
+        restarted.create();
+        assert(restarted.epoch() == 2);
+        assert(consumer.stale());
+        assert(consumer.attach(std::chrono::seconds(1), memory.size) == attach_result::ok);
+        assert(consumer.epoch() == 2 && !consumer.stale());
+    }
+
+    // the header is validated
+    {
+        segment_memory memory(object_t::required_size());
+        object_t producer(memory.data);
+        producer.create();
+
+        shared_segment_object<hope::threading::spmc_bounded_message_queue<int, 128>> other(memory.data);
+        assert(other.attach(std::chrono::seconds(1), memory.size) == attach_result::layout_mismatch);
+
+        object_t consumer(memory.data);
+        assert(consumer.attach(std::chrono::seconds(1), object_t::required_size() - 1) == attach_result::too_small);
+
+        reinterpret_cast<segment_header*>(memory.data)->magic = 0;
+        assert(consumer.attach(std::chrono::seconds(1), memory.size) == attach_result::bad_magic);
+    }
+
+    // runtime sized payload
+    {
+        using mpmc_t = hope::threading::shm_mpmc_bounded_queue<uint64_t>;
+        using mpmc_object_t = shared_segment_object<mpmc_t>;
+        const auto size = mpmc_object_t::required_size(mpmc_t::required_size(32));
+        segment_memory memory(size);
+        mpmc_object_t producer(memory.data);
+        auto* created = producer.create_with(mpmc_t::required_size(32), [](void* payload) {
+            return mpmc_t::create(payload, 32);
+        });
+        assert(created->try_enqueue(7));
+
+        mpmc_object_t consumer(memory.data);
+        assert(consumer.attach(std::chrono::seconds(1), memory.size) == attach_result::ok);
+        assert(consumer.get()->capacity() == 32);
+        uint64_t v = 0;
+        assert(consumer.get()->try_dequeue(v) && v == 7);
+        assert(consumer.attach(std::chrono::seconds(1), size - 1) == attach_result::too_small);
+    }
+}
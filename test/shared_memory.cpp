@@ -0,0 +1,96 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <cstring>
+
+#include <unistd.h>
+
+#include "hope_thread/platform/shared_memory.h"
+
+namespace {
+
+    using namespace hope::threading::platform;
+
+    // whatever backing is chosen, the segment is usable and shared between the mappings
+    void check_segment(const char* name, const shared_memory_options& options) {
+        constexpr std::size_t k_size = 64 * 1024;
+        unlink_shared_memory(name, options);
+
+        shared_memory_segment first;
+        assert(create_or_open_shared_memory(name, k_size, options, &first));
+        assert(first.created_new);
+        assert(first.size >= k_size);
+        assert(first.page_size != 0 && (first.page_size & (first.page_size - 1)) == 0);
+        assert(first.huge_pages || first.page_size == static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)));
+        assert(!first.huge_pages || first.size % first.page_size == 0);
+        std::memset(first.data, 0x5a, k_size);
+
+        shared_memory_segment second;
+        assert(create_or_open_shared_memory(name, k_size, options, &second));
+        assert(!second.created_new);
+        assert(second.huge_pages == first.huge_pages);
+        assert(static_cast<unsigned char*>(second.data)[k_size - 1] == 0x5a);
+
+        close_shared_memory(second);
+        close_shared_memory(first);
+        assert(first.data == nullptr && first.page_size == 0 && !first.locked);
+        assert(unlink_shared_memory(name, options));
+    }
+
+} // namespace
+
+void run_shared_memory_tests()
+{
+    check_segment("/hope_shm_plain_seg", shared_memory_options{ });
+
+    // falls back to the normal pages if there is no hugetlbfs mount or the pool is empty
+    {
+        shared_memory_options options;
+        options.huge_pages = true;
+        options.populate = true;
+        options.advice = memory_advice::will_need;
+        check_segment("/hope_shm_huge_seg", options);
+    }
+
+    // a segment the creator placed to the normal pages is opened, not created again, by a process asking for huge pages
+    {
+        constexpr std::size_t k_size = 64 * 1024;
+        const char* name = "/hope_shm_fallback_seg";
+        shared_memory_options huge;
+        huge.huge_pages = true;
+        unlink_shared_memory(name, huge);
+
+        shared_memory_segment created;
+        assert(create_or_open_shared_memory(name, k_size, shared_memory_options{ }, &created));
+        assert(created.created_new);
+        std::memset(created.data, 0x3c, k_size);
+
+        shared_memory_segment opened;
+        assert(create_or_open_shared_memory(name, k_size, huge, &opened));
+        assert(!opened.created_new && !opened.huge_pages);
+        assert(static_cast<unsigned char*>(opened.data)[0] == 0x3c);
+
+        close_shared_memory(opened);
+        close_shared_memory(created);
+        assert(unlink_shared_memory(name, huge));
+    }
+
+    // the lock might be refused by RLIMIT_MEMLOCK, the segment is created anyway
+    {
+        shared_memory_options options;
+        options.populate = true;
+        options.lock = true;
+        options.advice = memory_advice::sequential;
+        check_segment("/hope_shm_locked_seg", options);
+
+        options.hugetlbfs_dir = "/nonexistent_hugetlbfs";
+        options.huge_pages = true;
+        check_segment("/hope_shm_locked_seg", options);
+    }
+}
@@ -0,0 +1,133 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "hope_thread/containers/queue/shm_mpmc_bounded_queue.h"
+#include "hope_thread/platform/shared_memory.h"
+
+namespace {
+
+    struct job final {
+        uint64_t id;
+        uint64_t cost;
+    };
+
+    using queue_t = hope::threading::shm_mpmc_bounded_queue<job>;
+
+    // shared by the workers after the queue
+    struct alignas(CACHE_LINE_SIZE) results final {
+        std::atomic<uint64_t> done;
+        std::atomic<uint64_t> id_sum;
+    };
+
+    // several worker processes pull the jobs from one ring
+    void run_workers_test() {
+        constexpr const char* name = "/hope_shm_mpmc_seg";
+        constexpr std::size_t k_capacity = 256;
+        constexpr uint64_t k_jobs = 20000;
+        constexpr std::size_t k_workers = 3;
+        constexpr std::size_t shm_size = queue_t::required_size(k_capacity) + sizeof(results);
+
+        hope::threading::platform::unlink_shared_memory(name);
+        hope::threading::platform::shared_memory_segment segment;
+        assert(hope::threading::platform::create_or_open_shared_memory(name, shm_size, &segment));
+        auto* queue = queue_t::create(segment.data, k_capacity);
+        auto* shared = new (static_cast<char*>(segment.data) + queue_t::required_size(k_capacity)) results{ };
+
+        std::vector<pid_t> workers;
+        for (std::size_t w = 0; w < k_workers; ++w) {
+            const pid_t pid = fork();
+            assert(pid >= 0);
+            if (pid == 0) {
+                // the segment is mapped again, most likely at another address
+                hope::threading::platform::shared_memory_segment own;
+                if (!hope::threading::platform::create_or_open_shared_memory(name, shm_size, &own))
+                    std::_Exit(1);
+                auto* q = queue_t::attach(own.data);
+                auto* r = std::launder(reinterpret_cast<results*>(static_cast<char*>(own.data) + queue_t::required_size(q->capacity())));
+                if (q->capacity() != k_capacity)
+                    std::_Exit(1);
+                job j;
+                for (;;) {
+                    if (!q->try_dequeue(j))
+                        continue;
+                    if (j.id == k_jobs)
+                        break;
+                    if (j.cost != j.id * 3)
+                        std::_Exit(1);
+                    r->id_sum.fetch_add(j.id, std::memory_order_relaxed);
+                    r->done.fetch_add(1, std::memory_order_relaxed);
+                }
+                std::_Exit(0);
+            }
+            workers.push_back(pid);
+        }
+
+        for (uint64_t i = 0; i < k_jobs; ++i) {
+            while (!queue->try_enqueue(job{ i, i * 3 })) { }
+        }
+        // one stop job per worker
+        for (std::size_t w = 0; w < k_workers; ++w) {
+            while (!queue->try_enqueue(job{ k_jobs, 0 })) { }
+        }
+        for (auto pid : workers) {
+            int status = 0;
+            (void)waitpid(pid, &status, 0);
+            assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        }
+
+        assert(shared->done.load() == k_jobs);
+        assert(shared->id_sum.load() == k_jobs * (k_jobs - 1) / 2);
+        hope::threading::platform::close_shared_memory(segment);
+        hope::threading::platform::unlink_shared_memory(name);
+    }
+
+} // namespace
+
+void run_shm_mpmc_bounded_queue_tests()
+{
+    // the capacity lives in the block, attach does not reset the state
+    {
+        constexpr std::size_t k_capacity = 8;
+        auto* memory = ::operator new(queue_t::required_size(k_capacity), std::align_val_t{ CACHE_LINE_SIZE });
+        auto* q = queue_t::create(memory, k_capacity);
+        assert(q->capacity() == k_capacity);
+        for (uint64_t i = 0; i < k_capacity; ++i) {
+            assert(q->try_enqueue(job{ i, i * 3 }));
+        }
+        assert(!q->try_enqueue(job{ 8, 24 }));
+
+        auto* attached = queue_t::attach(memory);
+        assert(attached->capacity() == k_capacity);
+        assert(attached->size_approx() == k_capacity);
+
+        // wraps around several times
+        job j{ };
+        for (uint64_t i = 0; i < 10 * k_capacity; ++i) {
+            assert(attached->try_dequeue(j) && j.id == i && j.cost == i * 3);
+            assert(q->try_enqueue(job{ i + k_capacity, (i + k_capacity) * 3 }));
+        }
+        for (uint64_t i = 0; i < k_capacity; ++i) {
+            assert(q->try_dequeue(j));
+        }
+        assert(!q->try_dequeue(j));
+        ::operator delete(memory, std::align_val_t{ CACHE_LINE_SIZE });
+    }
+
+    run_workers_test();
+}
@@ -0,0 +1,185 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "hope_thread/core/slab_allocator.h"
+#include "hope_thread/containers/queue/spsc_queue.h"
+#include "hope_thread/containers/queue/mpsc_queue.h"
+#include "hope_thread/containers/queue/sutter_queue.h"
+#include "hope_thread/containers/hashmap/hash_set.h"
+#include "hope_thread/containers/hashmap/hash_map.h"
+
+namespace {
+
+    template<typename T>
+    using slab_t = hope::threading::slab_allocator<T>;
+
+    struct alignas(32) aligned_node final {
+        uint64_t payload[5];
+    };
+
+} // namespace
+
+void run_slab_allocator_tests()
+{
+    // a chunk is carved into several magazines at once
+    {
+        hope::threading::block_pool pool(48, 16, 1000);
+        assert(pool.blocks_per_chunk() == 1024);
+        std::vector<void*> blocks;
+        for (int i = 0; i < 1024; ++i) {
+            blocks.push_back(pool.allocate());
+        }
+        assert(pool.chunks_count() == 1);
+        for (auto* b : blocks) {
+            pool.deallocate(b);
+        }
+    }
+
+    // single nodes come from the slab, arrays from the heap
+    {
+        slab_t<aligned_node> alloc;
+        std::unordered_set<aligned_node*> unique;
+        std::vector<aligned_node*> nodes;
+        for (int i = 0; i < 5000; ++i) {
+            auto* n = alloc.allocate(1);
+            assert(reinterpret_cast<uintptr_t>(n) % alignof(aligned_node) == 0);
+            assert(unique.insert(n).second);
+            nodes.push_back(n);
+        }
+        for (auto* n : nodes) {
+            alloc.deallocate(n, 1);
+        }
+
+        auto* array = alloc.allocate(10);
+        alloc.deallocate(array, 10);
+
+        slab_t<int> rebound(alloc);
+        assert(rebound == alloc);
+    }
+
+    {
+        hope::threading::spsc_queue<std::string, slab_t<std::string>> q(16);
+        std::thread producer([&] {
+            for (int i = 0; i < 50000; ++i) {
+                q.enqueue(std::to_string(i));
+            }
+        });
+        std::string v;
+        for (int i = 0; i < 50000; ++i) {
+            while (!q.try_dequeue(v)) {
+                std::this_thread::yield();
+            }
+            assert(v == std::to_string(i));
+        }
+        producer.join();
+    }
+
+    // nodes are allocated by the producers and released by the consumer
+    {
+        constexpr int k_producers = 3;
+        constexpr int k_items = 20000;
+        hope::threading::mpsc_queue<int, hope::threading::alloc_policy::new_only, slab_t<int>> q;
+        std::vector<std::thread> producers;
+        for (int p = 0; p < k_producers; ++p) {
+            producers.emplace_back([&q, p] {
+                for (int i = 0; i < k_items; ++i) {
+                    q.enqueue(p * k_items + i);
+                }
+            });
+        }
+        std::vector<int> last(k_producers, -1);
+        int v;
+        for (int received = 0; received < k_producers * k_items;) {
+            if (!q.try_dequeue(v)) {
+                std::this_thread::yield();
+                continue;
+            }
+            const int producer = v / k_items;
+            assert(v % k_items > last[producer]);
+            last[producer] = v % k_items;
+            ++received;
+        }
+        for (auto&& t : producers) {
+            t.join();
+        }
+    }
+
+    {
+        hope::threading::mpsc_queue<std::string, hope::threading::alloc_policy::buffered, slab_t<std::string>> q;
+        std::string v;
+        for (int rep = 0; rep < 10; ++rep) {
+            for (int i = 0; i < 100; ++i) {
+                q.enqueue(std::to_string(i));
+            }
+            for (int i = 0; i < 100; ++i) {
+                assert(q.try_dequeue(v) && v == std::to_string(i));
+            }
+        }
+        q.enqueue(std::string("left in the queue"));
+    }
+
+    {
+        hope::threading::sutter_queue<std::string, slab_t<std::string>> q;
+        std::thread producer([&] {
+            for (int i = 0; i < 50000; ++i) {
+                q.enqueue(std::to_string(i));
+            }
+        });
+        std::string v;
+        for (int i = 0; i < 50000; ++i) {
+            while (!q.dequeue(v)) {
+                std::this_thread::yield();
+            }
+            assert(v == std::to_string(i));
+        }
+        producer.join();
+    }
+
+    // collision lists of both hash containers grow and shrink through the slab
+    {
+        using set_t = hope::threading::hash_set<int, std::hash<int>, hope::threading::trivial_equal_operator,
+            hope::threading::rw_spinlock, std::unique_lock, std::shared_lock, 8, 2, slab_t<int>>;
+        set_t set;
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 2; ++t) {
+            writers.emplace_back([&set, t] {
+                for (int i = t; i < 4000; i += 2) {
+                    set.emplace(i);
+                }
+            });
+        }
+        for (auto&& t : writers) {
+            t.join();
+        }
+        assert(set.size() == 4000);
+        for (int i = 0; i < 4000; ++i) {
+            assert(set.find(i) != nullptr);
+        }
+        for (int i = 0; i < 4000; i += 2) {
+            set.remove(i);
+        }
+        assert(set.size() == 2000);
+
+        using map_t = hope::threading::hash_map<std::string, int, std::hash, hope::threading::trivial_equal_operator,
+            hope::threading::rw_spinlock, std::unique_lock, std::shared_lock, 8, 2, slab_t<int>>;
+        map_t map;
+        for (int i = 0; i < 1000; ++i) {
+            map.emplace(std::to_string(i), i);
+        }
+        for (int i = 0; i < 1000; ++i) {
+            assert(map.get(std::to_string(i)).value() == i);
+        }
+    }
+}
@@ -8,12 +8,100 @@
 
 #include <cassert>
 #include <atomic>
+#include <cstdint>
 #include <thread>
 
 #include "hope_thread/containers/queue/spmc_bounded_message_queue.h"
 
+namespace {
+
+    // every word carries the same value, a torn read would mix two messages
+    struct wide_message final {
+        uint64_t words[8];
+    };
+
+    void run_overrun_detection_tests() {
+        using hope::threading::overrun_policy;
+
+        {
+            using queue_t = hope::threading::spmc_bounded_message_queue<int, 8, overrun_policy::detect>;
+            queue_t q;
+            auto c = q.create_consumer();
+            int v = -1;
+            assert(!c.try_dequeue(v));
+
+            for (int i = 0; i < 4; ++i) {
+                assert(q.try_enqueue(i));
+            }
+            assert(c.try_dequeue(v) && v == 0);
+            assert(c.overrun_count() == 0);
+
+            // positions 1..3 are overwritten by 9..11, 4..19 lap the consumer once more
+            for (int i = 4; i < 20; ++i) {
+                assert(q.try_enqueue(i));
+            }
+            for (int i = 12; i < 20; ++i) {
+                assert(c.try_dequeue(v) && v == i);
+            }
+            assert(!c.try_dequeue(v));
+            assert(c.overrun_count() == 11);
+        }
+
+        {
+            using queue_t = hope::threading::spmc_bounded_message_queue<wide_message, 16, overrun_policy::detect>;
+            constexpr uint64_t k_items = 200000;
+
+            queue_t q;
+            auto c = q.create_consumer();
+            std::atomic<bool> done{ false };
+
+            std::thread producer([&] {
+                for (uint64_t i = 0; i < k_items; ++i) {
+                    wide_message msg;
+                    for (auto&& w : msg.words) {
+                        w = i;
+                    }
+                    assert(q.try_enqueue(msg));
+                    if (i % 64 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+                done.store(true, std::memory_order_release);
+            });
+
+            uint64_t received = 0;
+            uint64_t next = 0;
+            for (;;) {
+                const bool finished = done.load(std::memory_order_acquire);
+                wide_message msg;
+                if (c.try_dequeue(msg)) {
+                    for (auto w : msg.words) {
+                        assert(w == msg.words[0]);
+                    }
+                    // lost messages are skipped, but never reordered or duplicated
+                    assert(msg.words[0] >= next);
+                    next = msg.words[0] + 1;
+                    ++received;
+                    continue;
+                }
+                if (finished) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            producer.join();
+
+            assert(next == k_items);
+            assert(received + c.overrun_count() == k_items);
+        }
+    }
+
+} // namespace
+
 void run_spmc_bounded_message_queue_tests()
 {
+    run_overrun_detection_tests();
+
     constexpr std::size_t k_capacity = 1024;
     using queue_t = hope::threading::spmc_bounded_message_queue<int, k_capacity>;
 
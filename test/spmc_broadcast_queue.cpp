@@ -0,0 +1,141 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/spmc_broadcast_queue.h"
+
+namespace {
+
+    // every consumer has to see every message in order, the slowest one throttles the producer
+    template<typename TWait>
+    void run_broadcast_test(std::size_t consumers_count, uint64_t k_items) {
+        using queue_t = hope::threading::spmc_broadcast_queue<uint64_t, 64, TWait>;
+
+        auto q = std::make_unique<queue_t>();
+        std::vector<typename queue_t::consumer> consumers;
+        for (std::size_t i = 0; i < consumers_count; ++i) {
+            consumers.push_back(q->create_consumer());
+            assert(consumers.back().valid());
+        }
+
+        std::vector<std::thread> ts;
+        std::atomic<std::size_t> finished{ 0 };
+        for (std::size_t i = 0; i < consumers_count; ++i) {
+            ts.emplace_back([&, i] {
+                auto&& c = consumers[i];
+                uint64_t expected = 0;
+                while (expected < k_items) {
+                    c.wait_and_consume([&](const uint64_t& v) {
+                        assert(v == expected);
+                        ++expected;
+                        // the first consumer is slow, the others must not overtake the producer
+                        if (i == 0 && v % 4096 == 0) {
+                            std::this_thread::sleep_for(std::chrono::microseconds(50));
+                        }
+                    }, 16);
+                }
+                finished.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+
+        for (uint64_t i = 0; i < k_items; ++i) {
+            q->enqueue(i);
+        }
+        for (auto&& t : ts) {
+            t.join();
+        }
+        assert(finished.load() == consumers_count);
+    }
+
+} // namespace
+
+void run_spmc_broadcast_queue_tests()
+{
+    // the producer gates on the slowest consumer
+    {
+        using queue_t = hope::threading::spmc_broadcast_queue<int, 8>;
+        queue_t q;
+        auto fast = q.create_consumer();
+        auto slow = q.create_consumer();
+
+        for (int i = 0; i < 8; ++i) {
+            assert(q.try_enqueue(i));
+        }
+        assert(!q.try_enqueue(8));
+
+        int v = -1;
+        for (int i = 0; i < 8; ++i) {
+            assert(fast.try_dequeue(v) && v == i);
+        }
+        assert(!fast.try_dequeue(v));
+        assert(!q.try_enqueue(8));
+
+        // batch: three slots are given back at once
+        int sum = 0;
+        assert(slow.consume([&](const int& item) { sum += item; }, 3) == 3);
+        assert(sum == 0 + 1 + 2);
+        assert(slow.lag() == 5);
+        for (int i = 8; i < 11; ++i) {
+            assert(q.try_enqueue(i));
+        }
+        assert(!q.try_enqueue(11));
+
+        // a released consumer does not gate anymore
+        slow = queue_t::consumer(std::move(fast));
+        for (int i = 8; i < 11; ++i) {
+            assert(slow.try_dequeue(v) && v == i);
+        }
+        for (int i = 11; i < 19; ++i) {
+            assert(q.try_enqueue(i));
+        }
+        assert(!q.try_enqueue(19));
+    }
+
+    // the slots are reused, the new consumer starts at the cursor
+    {
+        using queue_t = hope::threading::spmc_broadcast_queue<int, 8, hope::threading::yielding_wait, 2>;
+        queue_t q;
+        auto a = q.create_consumer();
+        auto b = q.create_consumer();
+        assert(a.valid() && b.valid());
+        assert(!q.create_consumer().valid());
+
+        assert(q.try_enqueue(1));
+        {
+            auto moved = std::move(b);
+            assert(!b.valid());
+        }
+        auto c = q.create_consumer();
+        assert(c.valid());
+        int v;
+        assert(!c.try_dequeue(v));
+        assert(q.try_enqueue(2));
+        assert(c.try_dequeue(v) && v == 2);
+        assert(a.try_dequeue(v) && v == 1);
+    }
+
+    // no consumers - nothing to wait for
+    {
+        hope::threading::spmc_broadcast_queue<int, 4> q;
+        for (int i = 0; i < 16; ++i) {
+            assert(q.try_enqueue(i));
+        }
+    }
+
+    // spinning threads might share a single core, keep the busy spin run short
+    run_broadcast_test<hope::threading::busy_spin_wait>(2, 2000);
+    run_broadcast_test<hope::threading::yielding_wait>(3, 100000);
+    run_broadcast_test<hope::threading::parking_wait>(3, 100000);
+}
@@ -6,32 +6,45 @@
  * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
  */
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
-#include <thread>
 #include <vector>
 
 #include <unistd.h>
 #include <sys/wait.h>
 
 #include "hope_thread/containers/queue/spmc_bounded_message_queue.h"
+#include "hope_thread/platform/futex.h"
+#include "hope_thread/platform/segment_header.h"
 #include "hope_thread/platform/shared_memory.h"
+#include "hope_thread/synchronization/interproc_notifier.h"
 
-constexpr std::size_t shm_size = 4 * 1024;
+namespace {
+
+    constexpr std::size_t k_capacity = 1024;
+    using queue_t = hope::threading::spmc_bounded_message_queue<int, k_capacity>;
+
+    // everything the processes share, placed after the segment header
+    struct channel final {
+        queue_t queue;
+        // the consumer sleeps on it instead of polling the queue
+        hope::threading::interproc_notifier notifier;
+        // the reader starts at the current position of the producer, so the producer waits for it
+        std::atomic<uint32_t> subscribers{ 0 };
+    };
+
+    using object_t = hope::threading::platform::shared_segment_object<channel>;
+
+} // namespace
 
 void run_interproc_test()
 {
-    // clear memory
-    {
-        hope::threading::platform::shared_memory_segment buffer;
-        assert(hope::threading::platform::create_or_open_shared_memory("/hope-shared_memory_test_seg",
-            shm_size, &buffer));
-        std::fill((char*)buffer.data, (char*)buffer.data + shm_size, 0);
-        hope::threading::platform::unlink_shared_memory("/hope-shared_memory_test_seg");
-    }
+    constexpr std::size_t shm_size = object_t::required_size();
 
-    constexpr std::size_t k_capacity = 1024;
+    hope::threading::platform::unlink_shared_memory("/hope-shared_memory_test_seg");
 
     std::vector<int> values;
     for (auto i = 0; i < k_capacity; ++i) {
@@ -39,19 +52,26 @@ void run_interproc_test()
     }
 
     if (auto pid = fork(); pid == 0) {
-        std::this_thread::sleep_for(std::chrono::seconds(2));
         // child - producer
         std::cout << "Initializing producer\n";
 
         hope::threading::platform::shared_memory_segment buffer;
-        assert(hope::threading::platform::create_or_open_shared_memory("/hope-shared_memory_test_seg",
-            shm_size, &buffer));
-        using queue_t = hope::threading::spmc_bounded_message_queue<int, k_capacity>;
-        auto* queue = new (buffer.data) queue_t();
+        const bool mapped = hope::threading::platform::create_or_open_shared_memory("/hope-shared_memory_test_seg",
+            shm_size, &buffer);
+        if (!mapped) {
+            assert(false && "the segment is not mapped");
+            std::abort();
+        }
+        object_t object(buffer.data);
+        auto* ch = object.create();
+        while (ch->subscribers.load(std::memory_order_acquire) == 0) {
+            hope::threading::platform::futex_wait(ch->subscribers, 0);
+        }
 
         std::cout << "Producing values\n";
         for (auto v : values) {
-            queue->try_enqueue(v);
+            ch->queue.try_enqueue(v);
+            ch->notifier.notify();
         }
         std::cout << "Finish producing values\n";
         std::_Exit(0);
@@ -59,22 +79,33 @@ void run_interproc_test()
          std::cout << "Initializing consumer\nChild proc:" << pid << '\n';
         // me - consumer
         hope::threading::platform::shared_memory_segment buffer;
-        assert(hope::threading::platform::create_or_open_shared_memory("/hope-shared_memory_test_seg",
-            shm_size, &buffer));
+        const bool mapped = hope::threading::platform::create_or_open_shared_memory("/hope-shared_memory_test_seg",
+            shm_size, &buffer);
+        if (!mapped) {
+            assert(false && "the segment is not mapped");
+            std::abort();
+        }
+
+        // waits until the producer publishes the channel
+        object_t object(buffer.data);
+        const auto attached = object.attach(std::chrono::seconds(30), buffer.size);
+        assert(attached == hope::threading::platform::attach_result::ok);
+        (void)attached;
+        auto* ch = object.get();
+        auto reader = ch->queue.create_consumer();
+        ch->subscribers.store(1, std::memory_order_release);
+        hope::threading::platform::futex_wake_all(ch->subscribers);
 
-        using queue_t = hope::threading::spmc_bounded_message_queue<int, k_capacity>;
-        auto* queue = (queue_t*)(buffer.data);
-        auto reader = queue->create_consumer();
         std::cout << "Consuming values" << std::endl;
         for (auto v : values) {
             int consumed = 0;
-            while (!reader.try_dequeue(consumed)) {
-                volatile int test = 0;
-            }
+            ch->notifier.wait([&] { return reader.try_dequeue(consumed); });
             assert(consumed == v);
         }
         std::cout << "All values was consumed" << std::endl;
         int status = 0;
         (void)waitpid(pid, &status, 0);
+        hope::threading::platform::close_shared_memory(buffer);
+        hope::threading::platform::unlink_shared_memory("/hope-shared_memory_test_seg");
     }
 }
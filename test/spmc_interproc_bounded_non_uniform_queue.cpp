@@ -6,51 +6,66 @@
  * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
  */
 
-#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
-#include <thread>
 #include <vector>
 
 #include <sys/wait.h>
 #include <unistd.h>
 
 #include "hope_thread/containers/queue/spmc_bounded_non_uniform_queue.h"
+#include "hope_thread/platform/futex.h"
+#include "hope_thread/platform/segment_header.h"
 #include "hope_thread/platform/shared_memory.h"
 
-void run_interproc_bounded_non_uniform_queue_test()
-{
-    constexpr std::size_t k_capacity = 1024;
+namespace {
+
+    constexpr std::size_t k_count = 1024;
+    // the ring is lossy, it holds every frame ([size][payload], 8 bytes each) so the reader is never lapped
+    constexpr std::size_t k_capacity = 16 * 1024;
     using queue_t = hope::threading::spmc_bounded_non_uniform_queue<k_capacity>;
 
+    struct channel final {
+        queue_t queue;
+        std::atomic<uint32_t> subscribers{ 0 };
+    };
+
+    using object_t = hope::threading::platform::shared_segment_object<channel>;
+
+} // namespace
+
+void run_interproc_bounded_non_uniform_queue_test()
+{
     std::vector<int> values;
-    for (auto i = 0; i < static_cast<int>(k_capacity); ++i) {
+    for (auto i = 0; i < static_cast<int>(k_count); ++i) {
         values.push_back(i);
     }
 
-    constexpr std::size_t shm_size = sizeof(queue_t) + 4096;
+    constexpr std::size_t shm_size = object_t::required_size();
 
-    {
-        hope::threading::platform::unlink_shared_memory("/hope_shm_nonuniq_seg");
-        hope::threading::platform::shared_memory_segment buffer;
-        assert(hope::threading::platform::create_or_open_shared_memory("/hope_shm_nonuniq_seg",
-            shm_size, &buffer));
-        std::fill(static_cast<char*>(buffer.data), static_cast<char*>(buffer.data) + shm_size, 0);
-    }
+    hope::threading::platform::unlink_shared_memory("/hope_shm_nonuniq_seg");
 
     const pid_t pid = fork();
     if (pid == 0) {
         hope::threading::platform::shared_memory_segment buffer;
-        assert(hope::threading::platform::create_or_open_shared_memory("/hope_shm_nonuniq_seg",
-            shm_size, &buffer));
-        auto* queue = new (buffer.data) queue_t();
-
-        std::this_thread::sleep_for(std::chrono::seconds(10));
+        const bool mapped = hope::threading::platform::create_or_open_shared_memory("/hope_shm_nonuniq_seg",
+            shm_size, &buffer);
+        if (!mapped) {
+            assert(false && "the segment is not mapped");
+            std::abort();
+        }
+        object_t object(buffer.data);
+        auto* ch = object.create();
+        while (ch->subscribers.load(std::memory_order_acquire) == 0) {
+            hope::threading::platform::futex_wait(ch->subscribers, 0);
+        }
 
         for (auto v : values) {
-            queue->seirialize([&v](uint8_t* p) {
+            ch->queue.seirialize([&v](uint8_t* p) {
                 std::memcpy(p, &v, sizeof(v));
             }, sizeof(v));
         }
@@ -60,11 +75,22 @@ void run_interproc_bounded_non_uniform_queue_test()
         assert(false && "fork failed");
     } else {
         hope::threading::platform::shared_memory_segment buffer;
-        assert(hope::threading::platform::create_or_open_shared_memory("/hope_shm_nonuniq_seg",
-            shm_size, &buffer));
+        const bool mapped = hope::threading::platform::create_or_open_shared_memory("/hope_shm_nonuniq_seg",
+            shm_size, &buffer);
+        if (!mapped) {
+            assert(false && "the segment is not mapped");
+            std::abort();
+        }
+
+        object_t object(buffer.data);
+        const auto attached = object.attach(std::chrono::seconds(30), buffer.size);
+        assert(attached == hope::threading::platform::attach_result::ok);
+        (void)attached;
+        auto* ch = object.get();
+        auto reader = ch->queue.create_consumer();
+        ch->subscribers.store(1, std::memory_order_release);
+        hope::threading::platform::futex_wake_all(ch->subscribers);
 
-        auto* queue = reinterpret_cast<queue_t*>(buffer.data);
-        auto reader = queue->create_consumer();
         std::cout << "Consuming non-uniform queue values (interproc)" << std::endl;
         for (auto v : values) {
             int consumed = 0;
@@ -81,5 +107,7 @@ void run_interproc_bounded_non_uniform_queue_test()
         std::cout << "All non-uniform queue values were consumed (interproc)" << std::endl;
         int status = 0;
         (void)waitpid(pid, &status, 0);
+        hope::threading::platform::close_shared_memory(buffer);
+        hope::threading::platform::unlink_shared_memory("/hope_shm_nonuniq_seg");
     }
 }
@@ -0,0 +1,134 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <cassert>
+#include <thread>
+
+#include "hope_thread/containers/queue/spsc_bounded_queue.h"
+
+void run_spsc_bounded_queue_tests()
+{
+    using queue_t = hope::threading::spsc_bounded_queue<int>;
+
+    {
+        queue_t q(4);
+        int v = -1;
+        assert(!q.try_dequeue(v));
+        for (int rep = 0; rep < 3; ++rep) {
+            for (int i = 0; i < 4; ++i) {
+                assert(q.try_enqueue(i));
+            }
+            assert(!q.try_enqueue(4));
+            for (int i = 0; i < 4; ++i) {
+                assert(q.try_dequeue(v) && v == i);
+            }
+            assert(!q.try_dequeue(v));
+        }
+    }
+
+    // bool slots are plain bools, the spans work for them as well
+    {
+        hope::threading::spsc_bounded_queue<bool> q(4);
+        auto span = q.write_span();
+        assert(span.size() == 4);
+        span[0] = true;
+        span[1] = false;
+        q.commit(2);
+        bool v = false;
+        assert(q.try_dequeue(v) && v);
+        assert(q.read_span().size() == 1 && !q.read_span()[0]);
+        q.release(1);
+        assert(!q.try_dequeue(v));
+    }
+
+    // spans never cross the end of the ring
+    {
+        queue_t q(8);
+        auto w = q.write_span();
+        assert(w.size() == 8);
+        for (int i = 0; i < 6; ++i) {
+            w[i] = i;
+        }
+        q.commit(6);
+        assert(q.write_span().size() == 2);
+
+        auto r = q.read_span();
+        assert(r.size() == 6);
+        assert(r[0] == 0 && r[5] == 5);
+        q.release(4);
+
+        // free space is 6, but only 2 slots are left till the end of the ring
+        w = q.write_span();
+        assert(w.size() == 2);
+        w[0] = 6;
+        w[1] = 7;
+        q.commit(2);
+        w = q.write_span();
+        assert(w.size() == 4);
+        w[0] = 8;
+        q.commit(1);
+
+        r = q.read_span();
+        assert(r.size() == 4);
+        assert(r[0] == 4 && r[3] == 7);
+        q.release(4);
+        int v = -1;
+        assert(q.try_dequeue(v) && v == 8);
+        assert(q.read_span().empty());
+    }
+
+    // batches go one way, single items the other way
+    {
+        constexpr int k_items = 200000;
+        queue_t q(64);
+
+        std::thread producer([&] {
+            int next = 0;
+            while (next < k_items) {
+                auto span = q.write_span();
+                std::size_t count = 0;
+                for (; count < span.size() && next < k_items; ++count) {
+                    span[count] = next++;
+                }
+                if (count == 0) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                q.commit(count);
+            }
+        });
+
+        std::thread consumer([&] {
+            int expected = 0;
+            while (expected < k_items) {
+                if (expected % 3 == 0) {
+                    int v = -1;
+                    if (q.try_dequeue(v)) {
+                        assert(v == expected);
+                        ++expected;
+                        continue;
+                    }
+                } else {
+                    auto span = q.read_span();
+                    for (auto v : span) {
+                        assert(v == expected);
+                        ++expected;
+                    }
+                    if (!span.empty()) {
+                        q.release(span.size());
+                        continue;
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+
+        producer.join();
+        consumer.join();
+    }
+}
@@ -6,11 +6,67 @@
  * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
  */
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <memory>
+#include <thread>
+
 #include "hope_thread/runtime/threadpool.h"
 
 void run_thread_pool_tests()
 {
-    hope::threading::thread_pool pool(16);
-    assert(true);
+    {
+        hope::threading::thread_pool pool(16);
+        assert(true);
+    }
+
+    // far more tasks in flight than the workers, the wrappers are not capped anymore
+    {
+        constexpr int k_tasks = 5000;
+        std::atomic<bool> release{ false };
+        std::atomic<int> done{ 0 };
+
+        hope::threading::thread_pool pool(4);
+        for (int i = 0; i < k_tasks; ++i) {
+            pool.add_work([&] {
+                while (!release.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                done.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        release.store(true, std::memory_order_release);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (done.load(std::memory_order_relaxed) != k_tasks && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        assert(done.load(std::memory_order_relaxed) == k_tasks);
+    }
+
+    // the work which was never executed is destroyed together with the pool
+    {
+        auto token = std::make_shared<int>(0);
+        std::atomic<bool> release{ false };
+        {
+            hope::threading::thread_pool pool(1);
+            pool.add_work([&] {
+                while (!release.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+            });
+            for (int i = 0; i < 100; ++i) {
+                pool.add_work([token] { });
+            }
+            assert(token.use_count() > 1);
+            std::thread releaser([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                release.store(true, std::memory_order_release);
+            });
+            pool.destroy();
+            releaser.join();
+        }
+        assert(token.use_count() == 1);
+    }
 }
@@ -0,0 +1,150 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/stack/freelist.h"
+#include "hope_thread/containers/stack/treiber_stack.h"
+#include "hope_thread/core/tagged_pointer.h"
+
+namespace {
+
+    struct buffer final : hope::threading::freelist_hook {
+        int owner{ -1 };
+        int uses{ 0 };
+    };
+
+} // namespace
+
+void run_treiber_stack_tests()
+{
+    {
+        int value = 0;
+        hope::threading::tagged_ptr<int> p(&value, 7);
+        assert(p.get_ptr() == &value && p.get_tag() == 7);
+        p.set_tag(8);
+        assert(p.get_ptr() == &value && p.get_tag() == 8);
+        p.set_ptr(nullptr);
+        assert(p.get_ptr() == nullptr && p.get_tag() == 8);
+
+        hope::threading::atomic_tagged_ptr<int> a({ &value, 1 });
+        hope::threading::tagged_ptr<int> expected(&value, 2);
+        assert(!a.compare_exchange_strong(expected, { nullptr, 3 }));
+        assert(expected.get_ptr() == &value && expected.get_tag() == 1);
+        assert(a.compare_exchange_strong(expected, { nullptr, 2 }));
+        assert(a.load().get_ptr() == nullptr && a.load().get_tag() == 2);
+    }
+
+    {
+        hope::threading::freelist<buffer> list;
+        assert(list.try_pop() == nullptr);
+        buffer a, b, c;
+        list.push(&a);
+        list.push(&b);
+        assert(list.try_pop() == &b);
+        b.freelist_next.store(&c);
+        list.push_chain(&b, &c);
+        assert(list.try_pop() == &b);
+        assert(list.try_pop() == &c);
+        assert(list.try_pop() == &a);
+        assert(list.try_pop() == nullptr);
+        assert(list.empty());
+    }
+
+    // buffers circulate between the threads, nobody can own the same buffer twice at a time
+    {
+        constexpr int k_threads = 4;
+        constexpr int k_buffers = 16;
+        constexpr int k_rounds = 50000;
+
+        hope::threading::freelist<buffer> list;
+        std::vector<buffer> buffers(k_buffers);
+        for (auto&& b : buffers) {
+            list.push(&b);
+        }
+
+        std::vector<std::thread> ts;
+        for (int t = 0; t < k_threads; ++t) {
+            ts.emplace_back([&, t] {
+                for (int i = 0; i < k_rounds; ++i) {
+                    auto* b = list.try_pop();
+                    if (b == nullptr) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    assert(b->owner == -1);
+                    b->owner = t;
+                    ++b->uses;
+                    assert(b->owner == t);
+                    b->owner = -1;
+                    list.push(b);
+                }
+            });
+        }
+        for (auto&& t : ts) {
+            t.join();
+        }
+
+        int count = 0;
+        while (list.try_pop() != nullptr) {
+            ++count;
+        }
+        assert(count == k_buffers);
+    }
+
+    {
+        hope::threading::treiber_stack<std::unique_ptr<std::string>> stack;
+        std::unique_ptr<std::string> v;
+        assert(!stack.try_pop(v));
+        for (int i = 0; i < 10; ++i) {
+            stack.push(std::make_unique<std::string>(std::to_string(i)));
+        }
+        for (int i = 9; i >= 5; --i) {
+            assert(stack.try_pop(v) && *v == std::to_string(i));
+        }
+        // the rest is destroyed with the stack
+    }
+
+    {
+        constexpr int k_threads = 4;
+        constexpr int k_items = 20000;
+
+        hope::threading::treiber_stack<int> stack;
+        std::vector<std::atomic<int>> seen(k_threads * k_items);
+        std::vector<std::thread> ts;
+        for (int t = 0; t < k_threads; ++t) {
+            ts.emplace_back([&, t] {
+                int v;
+                for (int i = 0; i < k_items; ++i) {
+                    stack.push(t * k_items + i);
+                    if (i % 2 == 1 && stack.try_pop(v)) {
+                        seen[v].fetch_add(1, std::memory_order_relaxed);
+                    }
+                    if (i % 256 == 0) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto&& t : ts) {
+            t.join();
+        }
+        int v;
+        while (stack.try_pop(v)) {
+            seen[v].fetch_add(1, std::memory_order_relaxed);
+        }
+        for (auto&& s : seen) {
+            assert(s.load() == 1);
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope_threading
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+
+#include "hope_thread/containers/queue/typed_message_queue.h"
+
+namespace {
+
+    struct heartbeat final {
+        uint8_t source;
+    };
+
+    struct order final {
+        uint64_t id;
+        double price;
+        uint32_t qty;
+    };
+
+    struct alignas(16) quote final {
+        uint64_t id;
+        int64_t bid;
+        int64_t ask;
+    };
+
+    using registry = hope::threading::message_registry<heartbeat, order, quote>;
+
+    static_assert(registry::id_of<heartbeat>() == 0);
+    static_assert(registry::id_of<order>() == 1);
+    static_assert(registry::id_of<quote>() == 2);
+    static_assert(!registry::contains<int>);
+
+    // counts what it has seen, checks that every view is aligned
+    struct visitor final {
+        void operator()(const heartbeat& h) {
+            assert(h.source == expected % 256);
+            ++heartbeats;
+        }
+
+        void operator()(const order& o) {
+            assert(reinterpret_cast<std::uintptr_t>(&o) % alignof(order) == 0);
+            assert(o.id == expected && o.price == double(expected) / 2 && o.qty == expected % 100);
+            ++orders;
+        }
+
+        void operator()(const quote& q) {
+            assert(reinterpret_cast<std::uintptr_t>(&q) % alignof(quote) == 0);
+            assert(q.id == expected && q.bid == -int64_t(expected) && q.ask == int64_t(expected));
+            ++quotes;
+        }
+
+        uint64_t expected{ 0 };
+        uint64_t heartbeats{ 0 };
+        uint64_t orders{ 0 };
+        uint64_t quotes{ 0 };
+    };
+
+    template<typename TQueue>
+    void publish(TQueue& q, uint64_t i) {
+        switch (i % 3) {
+            case 0: q.template publish<heartbeat>(uint8_t(i % 256)); break;
+            case 1: q.template publish<order>(i, double(i) / 2, uint32_t(i % 100)); break;
+            default: q.template publish<quote>(i, -int64_t(i), int64_t(i)); break;
+        }
+    }
+
+} // namespace
+
+void run_typed_message_queue_tests()
+{
+    // the ring wraps many times, every message is visited in place with its type
+    {
+        using queue_t = hope::threading::typed_message_queue<256, registry>;
+        auto q = std::make_unique<queue_t>();
+        auto consumer = q->create_consumer();
+
+        visitor v;
+        assert(!consumer.try_visit(v));
+        constexpr uint64_t k_count = 3000;
+        for (uint64_t i = 0; i < k_count; i += 4) {
+            // a few messages at once, fewer than the ring holds
+            for (uint64_t j = i; j < i + 4 && j < k_count; ++j) {
+                publish(*q, j);
+            }
+            for (uint64_t j = i; j < i + 4 && j < k_count; ++j) {
+                v.expected = j;
+                assert(consumer.try_visit(v));
+            }
+        }
+        assert(!consumer.try_visit(v));
+        assert(v.heartbeats == k_count / 3 && v.orders == k_count / 3 && v.quotes == k_count / 3);
+    }
+
+    // several consumers see the same messages, a visitor made of lambdas
+    {
+        using queue_t = hope::threading::typed_message_queue<1024, registry>;
+        auto q = std::make_unique<queue_t>();
+        auto first = q->create_consumer();
+        auto second = q->create_consumer();
+        q->publish<order>(uint64_t(7), 3.5, uint32_t(7));
+        q->publish<heartbeat>(uint8_t(1));
+
+        for (auto* c : { &first, &second }) {
+            uint64_t seen = 0;
+            auto lambdas = hope::threading::overloaded{
+                [&](const order& o) { assert(o.id == 7); seen += o.id; },
+                [&](const heartbeat& h) { seen += h.source; },
+                [&](const quote&) { assert(false); }
+            };
+            assert(c->try_visit(lambdas));
+            assert(c->try_visit(lambdas));
+            assert(!c->try_visit(lambdas));
+            assert(seen == 8);
+        }
+    }
+}
@@ -0,0 +1,105 @@
+/* Copyright (C) 2026 Gleb Bezborodov - All Rights Reserved
+ * You may use, distribute and modify this code under the
+ * terms of the MIT license.
+ *
+ * You should have received a copy of the MIT license with
+ * this file. If not, please write to: bezborodoff.gleb@gmail.com, or visit : https://github.com/glensand/hope-threading
+ */
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "hope_thread/containers/queue/work_stealing_deque.h"
+
+void run_work_stealing_deque_tests()
+{
+    using deque_t = hope::threading::work_stealing_deque<int>;
+
+    // the owner sees a stack, the thieves see a queue
+    {
+        deque_t d(4);
+        int v = -1;
+        assert(!d.pop(v));
+        assert(!d.steal(v));
+
+        for (int i = 0; i < 10; ++i) {
+            d.push(i);
+        }
+        assert(d.capacity() == 16);
+        assert(d.size() == 10);
+
+        assert(d.steal(v) && v == 0);
+        assert(d.steal(v) && v == 1);
+        assert(d.pop(v) && v == 9);
+        assert(d.pop(v) && v == 8);
+        for (int i = 2; i < 8; ++i) {
+            assert(d.steal(v) && v == i);
+        }
+        assert(!d.pop(v));
+        assert(!d.steal(v));
+        assert(d.empty());
+
+        d.push(42);
+        assert(d.pop(v) && v == 42);
+        assert(!d.pop(v));
+    }
+
+    // every item is taken exactly once, the owner keeps pushing past the initial capacity
+    {
+        constexpr int k_items = 200000;
+        constexpr int k_thieves = 3;
+
+        deque_t d(8);
+        auto taken = std::make_unique<std::atomic<int>[]>(k_items);
+        for (int i = 0; i < k_items; ++i) {
+            taken[i].store(0, std::memory_order_relaxed);
+        }
+        std::atomic<int> total{ 0 };
+        std::atomic<bool> done{ false };
+
+        std::vector<std::thread> thieves;
+        for (int t = 0; t < k_thieves; ++t) {
+            thieves.emplace_back([&] {
+                int v;
+                while (!done.load(std::memory_order_acquire)) {
+                    if (d.steal(v)) {
+                        taken[v].fetch_add(1, std::memory_order_relaxed);
+                        total.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        int v;
+        for (int i = 0; i < k_items; ++i) {
+            d.push(i);
+            if (i % 3 == 0 && d.pop(v)) {
+                taken[v].fetch_add(1, std::memory_order_relaxed);
+                total.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (i % 256 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        while (d.pop(v)) {
+            taken[v].fetch_add(1, std::memory_order_relaxed);
+            total.fetch_add(1, std::memory_order_relaxed);
+        }
+        while (total.load(std::memory_order_relaxed) != k_items) {
+            std::this_thread::yield();
+        }
+        done.store(true, std::memory_order_release);
+        for (auto&& t : thieves) {
+            t.join();
+        }
+
+        for (int i = 0; i < k_items; ++i) {
+            assert(taken[i].load(std::memory_order_relaxed) == 1);
+        }
+    }
+}